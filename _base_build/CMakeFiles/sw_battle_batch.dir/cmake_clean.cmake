@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sw_battle_batch.dir/tools/Batch/main.cpp.o"
+  "CMakeFiles/sw_battle_batch.dir/tools/Batch/main.cpp.o.d"
+  "sw_battle_batch"
+  "sw_battle_batch.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sw_battle_batch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
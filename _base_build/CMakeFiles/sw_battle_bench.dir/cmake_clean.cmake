@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sw_battle_bench.dir/tools/Bench/main.cpp.o"
+  "CMakeFiles/sw_battle_bench.dir/tools/Bench/main.cpp.o.d"
+  "sw_battle_bench"
+  "sw_battle_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sw_battle_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
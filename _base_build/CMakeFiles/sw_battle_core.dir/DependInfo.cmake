@@ -0,0 +1,30 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/Game/Parallel/ThreadPool.cpp" "CMakeFiles/sw_battle_core.dir/src/Game/Parallel/ThreadPool.cpp.o" "gcc" "CMakeFiles/sw_battle_core.dir/src/Game/Parallel/ThreadPool.cpp.o.d"
+  "/root/repo/src/Game/Profiling/Profiler.cpp" "CMakeFiles/sw_battle_core.dir/src/Game/Profiling/Profiler.cpp.o" "gcc" "CMakeFiles/sw_battle_core.dir/src/Game/Profiling/Profiler.cpp.o.d"
+  "/root/repo/src/Game/Snapshot/Snapshot.cpp" "CMakeFiles/sw_battle_core.dir/src/Game/Snapshot/Snapshot.cpp.o" "gcc" "CMakeFiles/sw_battle_core.dir/src/Game/Snapshot/Snapshot.cpp.o.d"
+  "/root/repo/src/Game/Units/Hunter.cpp" "CMakeFiles/sw_battle_core.dir/src/Game/Units/Hunter.cpp.o" "gcc" "CMakeFiles/sw_battle_core.dir/src/Game/Units/Hunter.cpp.o.d"
+  "/root/repo/src/Game/Units/Swordsman.cpp" "CMakeFiles/sw_battle_core.dir/src/Game/Units/Swordsman.cpp.o" "gcc" "CMakeFiles/sw_battle_core.dir/src/Game/Units/Swordsman.cpp.o.d"
+  "/root/repo/src/Game/Units/Unit.cpp" "CMakeFiles/sw_battle_core.dir/src/Game/Units/Unit.cpp.o" "gcc" "CMakeFiles/sw_battle_core.dir/src/Game/Units/Unit.cpp.o.d"
+  "/root/repo/src/IO/System/AsyncWriter.cpp" "CMakeFiles/sw_battle_core.dir/src/IO/System/AsyncWriter.cpp.o" "gcc" "CMakeFiles/sw_battle_core.dir/src/IO/System/AsyncWriter.cpp.o.d"
+  "/root/repo/src/IO/System/BinaryEventDecoder.cpp" "CMakeFiles/sw_battle_core.dir/src/IO/System/BinaryEventDecoder.cpp.o" "gcc" "CMakeFiles/sw_battle_core.dir/src/IO/System/BinaryEventDecoder.cpp.o.d"
+  "/root/repo/src/IO/System/BinaryEventLog.cpp" "CMakeFiles/sw_battle_core.dir/src/IO/System/BinaryEventLog.cpp.o" "gcc" "CMakeFiles/sw_battle_core.dir/src/IO/System/BinaryEventLog.cpp.o.d"
+  "/root/repo/src/IO/System/CommandParser.cpp" "CMakeFiles/sw_battle_core.dir/src/IO/System/CommandParser.cpp.o" "gcc" "CMakeFiles/sw_battle_core.dir/src/IO/System/CommandParser.cpp.o.d"
+  "/root/repo/src/IO/System/MappedFile.cpp" "CMakeFiles/sw_battle_core.dir/src/IO/System/MappedFile.cpp.o" "gcc" "CMakeFiles/sw_battle_core.dir/src/IO/System/MappedFile.cpp.o.d"
+  "/root/repo/src/IO/System/ProgramOptions.cpp" "CMakeFiles/sw_battle_core.dir/src/IO/System/ProgramOptions.cpp.o" "gcc" "CMakeFiles/sw_battle_core.dir/src/IO/System/ProgramOptions.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,33 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sw_battle_core.dir/src/Game/Parallel/ThreadPool.cpp.o"
+  "CMakeFiles/sw_battle_core.dir/src/Game/Parallel/ThreadPool.cpp.o.d"
+  "CMakeFiles/sw_battle_core.dir/src/Game/Profiling/Profiler.cpp.o"
+  "CMakeFiles/sw_battle_core.dir/src/Game/Profiling/Profiler.cpp.o.d"
+  "CMakeFiles/sw_battle_core.dir/src/Game/Snapshot/Snapshot.cpp.o"
+  "CMakeFiles/sw_battle_core.dir/src/Game/Snapshot/Snapshot.cpp.o.d"
+  "CMakeFiles/sw_battle_core.dir/src/Game/Units/Hunter.cpp.o"
+  "CMakeFiles/sw_battle_core.dir/src/Game/Units/Hunter.cpp.o.d"
+  "CMakeFiles/sw_battle_core.dir/src/Game/Units/Swordsman.cpp.o"
+  "CMakeFiles/sw_battle_core.dir/src/Game/Units/Swordsman.cpp.o.d"
+  "CMakeFiles/sw_battle_core.dir/src/Game/Units/Unit.cpp.o"
+  "CMakeFiles/sw_battle_core.dir/src/Game/Units/Unit.cpp.o.d"
+  "CMakeFiles/sw_battle_core.dir/src/IO/System/AsyncWriter.cpp.o"
+  "CMakeFiles/sw_battle_core.dir/src/IO/System/AsyncWriter.cpp.o.d"
+  "CMakeFiles/sw_battle_core.dir/src/IO/System/BinaryEventDecoder.cpp.o"
+  "CMakeFiles/sw_battle_core.dir/src/IO/System/BinaryEventDecoder.cpp.o.d"
+  "CMakeFiles/sw_battle_core.dir/src/IO/System/BinaryEventLog.cpp.o"
+  "CMakeFiles/sw_battle_core.dir/src/IO/System/BinaryEventLog.cpp.o.d"
+  "CMakeFiles/sw_battle_core.dir/src/IO/System/CommandParser.cpp.o"
+  "CMakeFiles/sw_battle_core.dir/src/IO/System/CommandParser.cpp.o.d"
+  "CMakeFiles/sw_battle_core.dir/src/IO/System/MappedFile.cpp.o"
+  "CMakeFiles/sw_battle_core.dir/src/IO/System/MappedFile.cpp.o.d"
+  "CMakeFiles/sw_battle_core.dir/src/IO/System/ProgramOptions.cpp.o"
+  "CMakeFiles/sw_battle_core.dir/src/IO/System/ProgramOptions.cpp.o.d"
+  "libsw_battle_core.a"
+  "libsw_battle_core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sw_battle_core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sw_battle_decode.dir/tools/Decode/main.cpp.o"
+  "CMakeFiles/sw_battle_decode.dir/tools/Decode/main.cpp.o.d"
+  "sw_battle_decode"
+  "sw_battle_decode.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sw_battle_decode.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
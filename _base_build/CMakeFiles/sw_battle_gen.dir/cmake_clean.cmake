@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sw_battle_gen.dir/tools/Generate/main.cpp.o"
+  "CMakeFiles/sw_battle_gen.dir/tools/Generate/main.cpp.o.d"
+  "sw_battle_gen"
+  "sw_battle_gen.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sw_battle_gen.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
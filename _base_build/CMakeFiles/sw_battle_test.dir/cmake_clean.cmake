@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sw_battle_test.dir/src/main.cpp.o"
+  "CMakeFiles/sw_battle_test.dir/src/main.cpp.o.d"
+  "sw_battle_test"
+  "sw_battle_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sw_battle_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
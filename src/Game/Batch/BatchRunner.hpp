@@ -0,0 +1,75 @@
+#pragma once
+
+#include "../GameState.hpp"
+#include "../Parallel/ThreadPool.hpp"
+#include <IO/System/EventLog.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace sw::game
+{
+    // How one battle of a batch ended
+    struct BattleOutcome
+    {
+        uint64_t seed = 0;
+        uint64_t ticks = 0;
+        size_t survivors = 0;
+        std::optional<int32_t> winner; // Set when exactly one unit is left
+    };
+
+    // Plays the same starting position many times with different seeds.
+    // Every run works on its own copy of the initial state and logs nothing, so runs share no
+    // mutable state and are spread over the thread pool one battle at a time.
+    class BatchRunner
+    {
+    private:
+        const GameState& _initialState;
+        ThreadPool& _threadPool;
+
+    public:
+        BatchRunner(const GameState& initialState, ThreadPool& threadPool)
+            : _initialState(initialState), _threadPool(threadPool) {}
+
+        // Outcomes in the order of the seeds
+        std::vector<BattleOutcome> run(const std::vector<uint64_t>& seeds) const
+        {
+            std::vector<BattleOutcome> outcomes(seeds.size());
+            _threadPool.parallelFor(seeds.size(), 1, [this, &seeds, &outcomes](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    outcomes[i] = runOne(seeds[i]);
+                }
+            });
+            return outcomes;
+        }
+
+        BattleOutcome runOne(uint64_t seed) const
+        {
+            sw::EventLog eventLog = sw::EventLog::discard();
+            SimulationOptions options;
+            options.seed = seed;
+            GameState state(_initialState, options, eventLog);
+            state.runSimulation();
+
+            BattleOutcome outcome;
+            outcome.seed = seed;
+            outcome.ticks = state.getCurrentTick();
+            outcome.survivors = state.getUnits().size();
+            if (outcome.survivors == 1)
+            {
+                const UnitStorage& units = state.getUnits();
+                for (UnitSlot slot = 0; slot < units.getSlotCount(); ++slot)
+                {
+                    if (!units.isRemoved(slot))
+                    {
+                        outcome.winner = units.getId(slot);
+                        break;
+                    }
+                }
+            }
+            return outcome;
+        }
+    };
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "FlatCellMap.hpp"
+#include "Position.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace sw::game
+{
+    // Set of map cells kept as a bitset with every row padded to whole words.
+    // Remembers which words it touched, so clear() costs O(inserted cells) rather than O(map).
+    // A sparse set, used alongside a sparse Map, keeps only its non-zero words in a hash table and
+    // clears them by erasing the touched keys, as clearing the whole table would cost its capacity.
+    class CellSet
+    {
+    private:
+        int32_t _width = 0;
+        int32_t _height = 0;
+        size_t _wordsPerRow = 0;
+        bool _sparse = false;
+        std::vector<uint64_t> _words;
+        std::vector<size_t> _touchedWords;
+        FlatCellMap<uint64_t> _sparseWords;
+
+        uint64_t wordAt(size_t word) const
+        {
+            if (!_sparse)
+            {
+                return _words[word];
+            }
+
+            const uint64_t* bits = _sparseWords.find(word);
+            return bits ? *bits : 0;
+        }
+
+    public:
+        void reset(int32_t width, int32_t height, bool sparse = false)
+        {
+            _width = width;
+            _height = height;
+            _sparse = sparse;
+            _wordsPerRow = (static_cast<size_t>(width) + 63) / 64;
+            _words.assign(sparse ? 0 : _wordsPerRow * static_cast<size_t>(height), 0);
+            _touchedWords.clear();
+            _sparseWords.clear();
+        }
+
+        bool isSparse() const { return _sparse; }
+        bool empty() const { return _touchedWords.empty(); }
+
+        void insert(const Position& pos)
+        {
+            const size_t word = static_cast<size_t>(pos.y) * _wordsPerRow + static_cast<size_t>(pos.x) / 64;
+            if (_sparse)
+            {
+                uint64_t& bits = _sparseWords[word];
+                if (bits == 0)
+                {
+                    _touchedWords.push_back(word);
+                }
+                bits |= uint64_t{1} << (pos.x % 64);
+                return;
+            }
+
+            if (_words[word] == 0)
+            {
+                _touchedWords.push_back(word);
+            }
+            _words[word] |= uint64_t{1} << (pos.x % 64);
+        }
+
+        void clear()
+        {
+            for (size_t word : _touchedWords)
+            {
+                if (_sparse)
+                {
+                    _sparseWords.erase(word);
+                }
+                else
+                {
+                    _words[word] = 0;
+                }
+            }
+            _touchedWords.clear();
+        }
+
+        // Whether any cell within the given Chebyshev distance of the center is in the set
+        bool intersectsSquare(const Position& center, int32_t radius) const
+        {
+            if (empty())
+            {
+                return false;
+            }
+
+            const auto x0 = static_cast<int32_t>(std::max<int64_t>(0, int64_t{center.x} - radius));
+            const auto x1 = static_cast<int32_t>(std::min<int64_t>(_width - 1, int64_t{center.x} + radius));
+            const auto y0 = static_cast<int32_t>(std::max<int64_t>(0, int64_t{center.y} - radius));
+            const auto y1 = static_cast<int32_t>(std::min<int64_t>(_height - 1, int64_t{center.y} + radius));
+            if (x0 > x1 || y0 > y1)
+            {
+                return false;
+            }
+
+            const size_t firstWord = static_cast<size_t>(x0) / 64;
+            const size_t lastWord = static_cast<size_t>(x1) / 64;
+            const uint64_t firstMask = ~uint64_t{0} << (x0 % 64);
+            const uint64_t lastMask = x1 % 64 == 63 ? ~uint64_t{0} : (uint64_t{1} << (x1 % 64 + 1)) - 1;
+            for (int32_t y = y0; y <= y1; ++y)
+            {
+                const size_t row = static_cast<size_t>(y) * _wordsPerRow;
+                for (size_t word = firstWord; word <= lastWord; ++word)
+                {
+                    uint64_t bits = wordAt(row + word);
+                    if (word == firstWord)
+                    {
+                        bits &= firstMask;
+                    }
+                    if (word == lastWord)
+                    {
+                        bits &= lastMask;
+                    }
+                    if (bits != 0)
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+    };
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace sw::game
+{
+    // Hash map from packed cell keys (see Map) to small values, stored in two flat arrays with
+    // linear probing. Erasing and clearing keep the capacity, so a table that has reached its
+    // working size stops allocating. The key ~0 is reserved to mark free entries.
+    template <typename TValue>
+    class FlatCellMap
+    {
+    private:
+        static constexpr uint64_t FREE_KEY = ~uint64_t{0};
+        static constexpr size_t MIN_CAPACITY = 16;
+
+        std::vector<uint64_t> _keys;
+        std::vector<TValue> _values;
+        size_t _size = 0;
+        uint32_t _shift = 64;
+
+        size_t home(uint64_t key) const
+        {
+            return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> _shift); // Fibonacci hashing
+        }
+
+        size_t mask() const { return _keys.size() - 1; }
+
+        // Index of the key, or of the free entry where it would go
+        size_t probe(uint64_t key) const
+        {
+            size_t index = home(key);
+            while (_keys[index] != key && _keys[index] != FREE_KEY)
+            {
+                index = (index + 1) & mask();
+            }
+            return index;
+        }
+
+        void grow()
+        {
+            std::vector<uint64_t> keys(_keys.empty() ? MIN_CAPACITY : _keys.size() * 2, FREE_KEY);
+            std::vector<TValue> values(keys.size());
+            keys.swap(_keys);
+            values.swap(_values);
+            _shift = 64 - static_cast<uint32_t>(std::countr_zero(_keys.size()));
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                if (keys[i] != FREE_KEY)
+                {
+                    const size_t index = probe(keys[i]);
+                    _keys[index] = keys[i];
+                    _values[index] = values[i];
+                }
+            }
+        }
+
+    public:
+        bool empty() const { return _size == 0; }
+        size_t size() const { return _size; }
+
+        const TValue* find(uint64_t key) const
+        {
+            if (_size == 0)
+            {
+                return nullptr;
+            }
+
+            const size_t index = probe(key);
+            return _keys[index] == key ? &_values[index] : nullptr;
+        }
+
+        TValue* find(uint64_t key)
+        {
+            return const_cast<TValue*>(static_cast<const FlatCellMap*>(this)->find(key));
+        }
+
+        // Value of the key, inserted as TValue{} if missing
+        TValue& operator[](uint64_t key)
+        {
+            if ((_size + 1) * 2 > _keys.size())
+            {
+                grow();
+            }
+
+            const size_t index = probe(key);
+            if (_keys[index] == FREE_KEY)
+            {
+                _keys[index] = key;
+                _values[index] = TValue{};
+                ++_size;
+            }
+            return _values[index];
+        }
+
+        void erase(uint64_t key)
+        {
+            if (_size == 0)
+            {
+                return;
+            }
+
+            size_t hole = probe(key);
+            if (_keys[hole] != key)
+            {
+                return;
+            }
+
+            // Shifts later entries of the probe run back into the hole, so lookups need no tombstones
+            for (size_t next = (hole + 1) & mask(); _keys[next] != FREE_KEY; next = (next + 1) & mask())
+            {
+                const size_t wanted = home(_keys[next]);
+                const bool staysAfterHole = hole < next ? (wanted > hole && wanted <= next) : (wanted > hole || wanted <= next);
+                if (!staysAfterHole)
+                {
+                    _keys[hole] = _keys[next];
+                    _values[hole] = _values[next];
+                    hole = next;
+                }
+            }
+            _keys[hole] = FREE_KEY;
+            --_size;
+        }
+
+        // Makes room for count entries, so inserting up to that many never allocates
+        void reserve(size_t count)
+        {
+            while ((count + 1) * 2 > _keys.size())
+            {
+                grow();
+            }
+        }
+
+        // Calls callback(key, value) for every entry, in no particular order
+        template <typename TCallback>
+        void forEach(TCallback&& callback) const
+        {
+            for (size_t i = 0; i < _keys.size(); ++i)
+            {
+                if (_keys[i] != FREE_KEY)
+                {
+                    callback(_keys[i], _values[i]);
+                }
+            }
+        }
+
+        // O(capacity); erase() the keys one by one when only a few of a large table are in use
+        void clear()
+        {
+            if (_size != 0)
+            {
+                std::fill(_keys.begin(), _keys.end(), FREE_KEY);
+                _size = 0;
+            }
+        }
+    };
+}
@@ -3,12 +3,14 @@
 #include "GameState.hpp"
 #include "Units/Swordsman.hpp"
 #include "Units/Hunter.hpp"
+#include "Snapshot/Snapshot.hpp"
 #include <IO/Commands/CreateMap.hpp>
 #include <IO/Commands/SpawnSwordsman.hpp>
 #include <IO/Commands/SpawnHunter.hpp>
 #include <IO/Commands/March.hpp>
 #include <IO/Events/MarchStarted.hpp>
 #include <memory>
+#include <string_view>
 
 namespace sw::game
 {
@@ -17,17 +19,19 @@ namespace sw::game
     private:
         std::unique_ptr<GameState> _gameState;
         sw::EventLog& _eventLog;
+        SimulationOptions _options;
         bool _isInitialized;
 
     public:
-        GameController(sw::EventLog& eventLog)
-            : _gameState(nullptr), _eventLog(eventLog), _isInitialized(false) {}
+        GameController(sw::EventLog& eventLog, const SimulationOptions& options)
+            : _gameState(nullptr), _eventLog(eventLog), _options(options), _isInitialized(false) {}
 
         void handleCreateMap(const io::CreateMap& command)
         {
             _gameState = std::make_unique<GameState>(
                 static_cast<int32_t>(command.width),
                 static_cast<int32_t>(command.height),
+                _options,
                 _eventLog
             );
             _isInitialized = true;
@@ -40,14 +44,14 @@ namespace sw::game
                 throw std::runtime_error("Game not initialized. Create a map first.");
             }
 
-            auto swordsman = std::make_shared<Swordsman>(
+            bool spawned = _gameState->addUnit<Swordsman>(
                 static_cast<int32_t>(command.unitId),
                 Position(static_cast<int32_t>(command.x), static_cast<int32_t>(command.y)),
                 static_cast<int32_t>(command.hp),
-                static_cast<int32_t>(command.strength)
+                Swordsman::Stats{static_cast<int32_t>(command.strength)}
             );
 
-            if (!_gameState->addUnit(swordsman))
+            if (!spawned)
             {
                 throw std::runtime_error("Failed to spawn swordsman. Position might be occupied or invalid.");
             }
@@ -60,16 +64,18 @@ namespace sw::game
                 throw std::runtime_error("Game not initialized. Create a map first.");
             }
 
-            auto hunter = std::make_shared<Hunter>(
+            bool spawned = _gameState->addUnit<Hunter>(
                 static_cast<int32_t>(command.unitId),
                 Position(static_cast<int32_t>(command.x), static_cast<int32_t>(command.y)),
                 static_cast<int32_t>(command.hp),
-                static_cast<int32_t>(command.agility),
-                static_cast<int32_t>(command.strength),
-                static_cast<int32_t>(command.range)
+                Hunter::Stats{
+                    static_cast<int32_t>(command.agility),
+                    static_cast<int32_t>(command.strength),
+                    static_cast<int32_t>(command.range)
+                }
             );
 
-            if (!_gameState->addUnit(hunter))
+            if (!spawned)
             {
                 throw std::runtime_error("Failed to spawn hunter. Position might be occupied or invalid.");
             }
@@ -89,18 +95,39 @@ namespace sw::game
             }
 
             Position target(static_cast<int32_t>(command.targetX), static_cast<int32_t>(command.targetY));
-            unit->setTargetPosition(target);
+            _gameState->setMarchTarget(unit->getSlot(), target);
 
             // Log march started event
-            _gameState->logEvent(io::MarchStarted{
-                command.unitId,
-                static_cast<uint32_t>(unit->getPosition().x),
-                static_cast<uint32_t>(unit->getPosition().y),
-                command.targetX,
-                command.targetY
+            _gameState->logEvent([&command, &unit]
+            {
+                return io::MarchStarted{
+                    command.unitId,
+                    static_cast<uint32_t>(unit->getPosition().x),
+                    static_cast<uint32_t>(unit->getPosition().y),
+                    command.targetX,
+                    command.targetY
+                };
             });
         }
 
+        // Continues a battle saved in a snapshot instead of setting one up with commands
+        void restoreSnapshot(std::string_view data)
+        {
+            _gameState = readSnapshot(data, _options, _eventLog);
+            _isInitialized = true;
+        }
+
+        // State of the battle set up by the commands so far
+        const GameState& getGameState() const
+        {
+            if (!_isInitialized)
+            {
+                throw std::runtime_error("Game not initialized. Create a map first.");
+            }
+
+            return *_gameState;
+        }
+
         void runSimulation()
         {
             if (!_isInitialized)
@@ -110,5 +137,17 @@ namespace sw::game
 
             _gameState->runSimulation();
         }
+
+        // Runs the battle while takeCommands(tick) applies the scripted commands due at each tick
+        template <typename TTakeCommands>
+        void runSimulation(TTakeCommands&& takeCommands)
+        {
+            if (!_isInitialized)
+            {
+                throw std::runtime_error("Game not initialized. Create a map first.");
+            }
+
+            _gameState->runSimulation(std::forward<TTakeCommands>(takeCommands));
+        }
     };
 } 
\ No newline at end of file
@@ -1,7 +1,22 @@
 #pragma once
 
+#include "CellSet.hpp"
+#include "FlatCellMap.hpp"
 #include "Map.hpp"
+#include "SimulationOptions.hpp"
+#include "SpatialIndex.hpp"
+#include "TurnQueue.hpp"
+#include "Parallel/ThreadPool.hpp"
+#include "Pathing/PathPlanner.hpp"
+#include "Profiling/Profiler.hpp"
+#include "Snapshot/SnapshotWriter.hpp"
+#include "RandomStream.hpp"
 #include "Units/Unit.hpp"
+#include "Units/UnitAction.hpp"
+#include "Units/UnitStorage.hpp"
+#include "Units/Swordsman.hpp"
+#include "Units/Hunter.hpp"
+#include "Units/UnitTypes.hpp"
 #include <IO/Events/UnitMoved.hpp>
 #include <IO/Events/UnitAttacked.hpp>
 #include <IO/Events/UnitDied.hpp>
@@ -10,9 +25,13 @@
 #include <IO/Events/UnitSpawned.hpp>
 #include <IO/Events/MapCreated.hpp>
 #include <IO/System/EventLog.hpp>
-#include <unordered_map>
+#include <algorithm>
+#include <bit>
 #include <memory>
-#include <random>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace sw::game
@@ -21,179 +40,638 @@ namespace sw::game
     {
     private:
         Map _map;
-        std::unordered_map<int32_t, UnitPtr> _units;
+        UnitStorage _units;
+        TurnQueue _turnQueue;
+        PathPlanner _pathPlanner;
         uint64_t _currentTick;
-        mutable std::mt19937 _randomEngine;
-        sw::EventLog& _eventLog;
+        SimulationOptions _options;
+        sw::EventLog* _eventLog;
         static constexpr uint64_t MAX_TICKS = 1000; // Maximum number of ticks to prevent hanging
 
+        // Hang detection: ticks in a row the number of active units stayed at _previousActiveCount
+        uint64_t _ticksWithoutChanges = 0;
+        uint64_t _previousActiveCount = 0;
+
+        // Parallel ticks: below this many queued units the threads cost more than they save
+        static constexpr size_t PARALLEL_MIN_UNITS = 1024;
+        static constexpr size_t PARALLEL_CHUNK = 256;
+        std::vector<UnitSlot> _plannedSlots;
+        std::vector<UnitAction> _plannedActions;
+        CellSet _movedCells; // Cells left or entered by a move so far this tick
+        bool _trackMoves = false;
+
+        // Sleeping units per block of the map, so a change far from every sleeper is dismissed
+        // after a lookup or two instead of a scan of the cells around it
+        static constexpr int32_t SLEEPER_BLOCK = 32;
+        FlatCellMap<uint32_t> _sleeperBlocks;
+
+        struct RestoreTag {};
+
+        // Empty battle that readSnapshot() fills in; logs nothing
+        GameState(RestoreTag, int32_t width, int32_t height, const SimulationOptions& options, sw::EventLog& eventLog)
+            : _map(width, height), _currentTick(1), _options(options), _eventLog(&eventLog)
+        {
+            if (_options.threadPool)
+            {
+                _movedCells.reset(width, height, _map.isSparse());
+            }
+        }
+
     public:
-        GameState(int32_t width, int32_t height, sw::EventLog& eventLog)
-            : _map(width, height), _currentTick(1), _randomEngine(std::random_device{}()), _eventLog(eventLog)
+        static constexpr double ADJACENT_RANGE = 1.5; // Slightly more than sqrt(2) to include diagonals
+
+        GameState(int32_t width, int32_t height, const SimulationOptions& options, sw::EventLog& eventLog)
+            : _map(width, height), _currentTick(1), _options(options), _eventLog(&eventLog)
         {
-            _eventLog.log(_currentTick, io::MapCreated{static_cast<uint32_t>(width), static_cast<uint32_t>(height)});
+            if (_options.threadPool)
+            {
+                _movedCells.reset(width, height, _map.isSparse());
+            }
+            _eventLog->log(_currentTick, io::MapCreated{static_cast<uint32_t>(width), static_cast<uint32_t>(height)});
         }
 
+        // Copy of another battle that continues with its own options and event log
+        GameState(const GameState& other, const SimulationOptions& options, sw::EventLog& eventLog)
+            : GameState(other)
+        {
+            _options = options;
+            _eventLog = &eventLog;
+            if (_options.threadPool)
+            {
+                _movedCells.reset(_map.getWidth(), _map.getHeight(), _map.isSparse());
+            }
+        }
+
+        GameState(const GameState&) = default;
+
+        friend void writeSnapshot(const GameState& state, std::vector<char>& output);
+        friend std::unique_ptr<GameState> readSnapshot(std::string_view data, const SimulationOptions& options, sw::EventLog& eventLog);
+
         Map& getMap() { return _map; }
         const Map& getMap() const { return _map; }
+
+        UnitStorage& getUnits() { return _units; }
+        const UnitStorage& getUnits() const { return _units; }
+
+        const PathPlanner& getPathPlanner() const { return _pathPlanner; }
         
         uint64_t getCurrentTick() const { return _currentTick; }
+        uint64_t getSeed() const { return _options.seed; }
         void nextTick() { ++_currentTick; }
 
-        template <typename TEvent>
-        void logEvent(TEvent&& event)
+        // Always null when profiling is compiled out, which lets the hooks fold away
+        Profiler* getProfiler() const
+        {
+            if constexpr (PROFILING_COMPILED)
+            {
+                return _options.profiler;
+            }
+            return nullptr;
+        }
+
+        void count(ProfileCounter counter, uint64_t amount = 1) const
+        {
+            if (Profiler* profiler = getProfiler())
+            {
+                profiler->count(counter, amount);
+            }
+        }
+
+        // makeEvent() builds the event; it is only called when someone subscribed to the event's type
+        template <typename TMakeEvent>
+        void logEvent(TMakeEvent&& makeEvent)
         {
-            _eventLog.log(_currentTick, std::forward<TEvent>(event));
+            if (!_eventLog->isSubscribed<std::invoke_result_t<TMakeEvent&>>())
+            {
+                return;
+            }
+            count(ProfileCounter::EventsLogged);
+            _eventLog->log(_currentTick, makeEvent());
         }
 
-        bool addUnit(UnitPtr unit)
+        template <typename TUnit>
+        bool addUnit(int32_t unitId, const Position& position, int32_t hp, const typename TUnit::Stats& stats)
         {
-            if (_units.find(unit->getId()) != _units.end())
+            if (_units.contains(unitId))
             {
                 return false; // Unit with this ID already exists
             }
 
-            if (!_map.placeUnit(unit->getPosition(), unit->getId()))
+            if (_map.isOccupied(position))
             {
                 return false; // Position is occupied or invalid
             }
 
-            _units[unit->getId()] = unit;
-            logEvent(io::UnitSpawned{
-                static_cast<uint32_t>(unit->getId()), 
-                unit->getType(), 
-                static_cast<uint32_t>(unit->getPosition().x), 
-                static_cast<uint32_t>(unit->getPosition().y)
+            const UnitSlot slot = _units.add(unitId, position, hp, stats);
+            _map.placeUnit(position, slot);
+            _turnQueue.push(slot);
+            _pathPlanner.onCellChanged(position, true, std::nullopt);
+            wakeAround(position);
+
+            logEvent([unitId, &position]
+            {
+                return io::UnitSpawned{
+                    static_cast<uint32_t>(unitId), 
+                    TUnit::Stats::Name, 
+                    static_cast<uint32_t>(position.x), 
+                    static_cast<uint32_t>(position.y)
+                };
             });
             return true;
         }
 
         bool removeUnit(int32_t unitId)
         {
-            auto it = _units.find(unitId);
-            if (it == _units.end())
+            auto slot = _units.findSlot(unitId);
+            if (!slot)
             {
                 return false;
             }
 
-            _map.removeUnit(it->second->getPosition());
-            _units.erase(it);
+            removeUnitAt(*slot);
             return true;
         }
 
-        UnitPtr getUnit(int32_t unitId) const
+        void removeUnitAt(UnitSlot slot)
+        {
+            setMarchTarget(slot, std::nullopt);
+            _pathPlanner.onCellChanged(_units.getPosition(slot), false, std::nullopt);
+            _map.removeUnit(_units.getPosition(slot));
+            wakeUnit(slot);
+            _turnQueue.remove(slot);
+            wakeAround(_units.getPosition(slot));
+            _units.remove(slot);
+        }
+
+        // Moves a unit to a free cell, keeping the map and the path planner in sync
+        bool moveUnit(UnitSlot slot, const Position& to)
         {
-            auto it = _units.find(unitId);
-            if (it == _units.end())
+            const Position from = _units.getPosition(slot);
+            count(ProfileCounter::MovesAttempted);
+            if (!_map.moveUnit(from, to))
             {
-                return nullptr;
+                count(ProfileCounter::MovesBlocked);
+                return false;
             }
-            return it->second;
+
+            _units.setPosition(slot, to);
+            if (_trackMoves)
+            {
+                _movedCells.insert(from);
+                _movedCells.insert(to);
+            }
+            const auto& target = _units.getTarget(slot);
+            _pathPlanner.onCellChanged(from, false, target);
+            _pathPlanner.onCellChanged(to, true, target);
+            wakeAround(from, to);
+            return true;
         }
 
-        std::vector<UnitPtr> getUnitsInRange(const Position& center, double range) const
+        // Starts, redirects or (with nullopt) ends a unit's march
+        void setMarchTarget(UnitSlot slot, const std::optional<Position>& target)
         {
-            std::vector<UnitPtr> result;
-            for (const auto& [id, unit] : _units)
+            _pathPlanner.onTargetChanged(slot, _units.getPosition(slot), _units.getTarget(slot), target);
+            _units.setTarget(slot, target);
+            wakeUnit(slot);
+        }
+
+        // Wakes the sleeping units whose last decision read the cell, which has just been
+        // entered or left. A move passes both of its cells, which are next to each other.
+        void wakeAround(const Position& cell)
+        {
+            wakeAround(cell, cell);
+        }
+
+        void wakeAround(const Position& cell, const Position& otherCell)
+        {
+            if (_sleeperBlocks.empty())
+            {
+                return;
+            }
+
+            const int32_t reach = _turnQueue.getMaxSleepReach();
+            const int32_t firstX = std::max(0, std::min(cell.x, otherCell.x) - reach) / SLEEPER_BLOCK;
+            const int32_t lastX = std::min(_map.getWidth() - 1, std::max(cell.x, otherCell.x) + reach) / SLEEPER_BLOCK;
+            const int32_t firstY = std::max(0, std::min(cell.y, otherCell.y) - reach) / SLEEPER_BLOCK;
+            const int32_t lastY = std::min(_map.getHeight() - 1, std::max(cell.y, otherCell.y) + reach) / SLEEPER_BLOCK;
+            bool nearSleepers = false;
+            for (int32_t y = firstY; y <= lastY && !nearSleepers; ++y)
+            {
+                for (int32_t x = firstX; x <= lastX && !nearSleepers; ++x)
+                {
+                    nearSleepers = _sleeperBlocks.find(blockKey(x, y)) != nullptr;
+                }
+            }
+            if (!nearSleepers)
             {
-                if (unit->getPosition().distanceTo(center) <= range)
+                return;
+            }
+
+            const int32_t scanReach = cell == otherCell ? reach : reach + 1;
+            getSpatialIndex().forEachInSquare(cell, scanReach, [this, &cell, &otherCell](UnitSlot slot, const Position& position)
+            {
+                const int64_t distance = std::min(position.chebyshevDistanceTo(cell), position.chebyshevDistanceTo(otherCell));
+                if (_turnQueue.isAsleep(slot) && distance <= _turnQueue.getSleepReach(slot))
                 {
-                    result.push_back(unit);
+                    wakeUnit(slot);
+                    count(ProfileCounter::UnitsWoken);
                 }
+            });
+        }
+
+        // A unit with no march target that chose to do nothing would choose the same again and
+        // again until one of the cells it looked at changes, so it sleeps until then
+        void settle(UnitSlot slot, const UnitAction& action)
+        {
+            if (action.kind != UnitAction::Kind::None || _units.getTarget(slot))
+            {
+                return;
+            }
+
+            _turnQueue.sleep(slot, action.reach);
+            ++_sleeperBlocks[blockKey(_units.getPosition(slot))];
+        }
+
+        // Makes room for every unit to sleep in a block of its own, so that settle() never
+        // allocates during the turns
+        void reserveSleeperBlocks()
+        {
+            const uint64_t blockCount = static_cast<uint64_t>((_map.getWidth() + SLEEPER_BLOCK - 1) / SLEEPER_BLOCK)
+                * static_cast<uint64_t>((_map.getHeight() + SLEEPER_BLOCK - 1) / SLEEPER_BLOCK);
+            _sleeperBlocks.reserve(static_cast<size_t>(std::min<uint64_t>(_units.size(), blockCount)));
+        }
+
+        void wakeUnit(UnitSlot slot)
+        {
+            if (!_turnQueue.wake(slot))
+            {
+                return;
+            }
+
+            const uint64_t key = blockKey(_units.getPosition(slot));
+            uint32_t* sleepers = _sleeperBlocks.find(key);
+            if (--*sleepers == 0)
+            {
+                _sleeperBlocks.erase(key);
+            }
+        }
+
+        static uint64_t blockKey(int32_t blockX, int32_t blockY)
+        {
+            return (static_cast<uint64_t>(blockY) << 32) | static_cast<uint32_t>(blockX);
+        }
+
+        static uint64_t blockKey(const Position& position)
+        {
+            return blockKey(position.x / SLEEPER_BLOCK, position.y / SLEEPER_BLOCK);
+        }
+
+        std::optional<Unit> getUnit(int32_t unitId)
+        {
+            auto slot = _units.findSlot(unitId);
+            if (!slot)
+            {
+                return std::nullopt;
+            }
+            return Unit(_units, *slot);
+        }
+
+        SpatialIndex getSpatialIndex() const { return SpatialIndex(_map); }
+
+        // Calls callback(UnitSlot) for every unit whose distance from the center lies
+        // within [minRange, maxRange], visiting only the map cells of that ring
+        template <typename TCallback>
+        void forEachUnitInAnnulus(const Position& center, double minRange, double maxRange, TCallback&& callback) const
+        {
+            if (Profiler* profiler = getProfiler())
+            {
+                uint64_t candidates = 0;
+                getSpatialIndex().forEachInAnnulus(center,
+                    SpatialIndex::toMinDistanceSq(minRange), SpatialIndex::toDistanceSq(maxRange),
+                    [&callback, &candidates](UnitSlot slot, const Position&) { ++candidates; callback(slot); });
+                profiler->count(ProfileCounter::RangeQueries);
+                profiler->count(ProfileCounter::CandidatesExamined, candidates);
+                return;
             }
-            return result;
+
+            getSpatialIndex().forEachInAnnulus(center,
+                SpatialIndex::toMinDistanceSq(minRange), SpatialIndex::toDistanceSq(maxRange),
+                [&callback](UnitSlot slot, const Position&) { callback(slot); });
         }
 
-        std::vector<UnitPtr> getAdjacentUnits(const Position& position) const
+        // Calls callback(UnitSlot) for every unit within the given distance of the center
+        template <typename TCallback>
+        void forEachUnitInRange(const Position& center, double range, TCallback&& callback) const
         {
-            return getUnitsInRange(position, 1.5); // Slightly more than sqrt(2) to include diagonals
+            forEachUnitInAnnulus(center, 0.0, range, std::forward<TCallback>(callback));
         }
 
-        UnitPtr getRandomUnit(const std::vector<UnitPtr>& units) const
+        // Collects the units within range into the caller's buffer, which keeps its capacity between
+        // calls. The span views the buffer.
+        std::span<const UnitSlot> getUnitsInRange(const Position& center, double range, std::vector<UnitSlot>& buffer) const
+        {
+            buffer.clear();
+            forEachUnitInRange(center, range, [&buffer](UnitSlot slot) { buffer.push_back(slot); });
+            return buffer;
+        }
+
+        std::span<const UnitSlot> getAdjacentUnits(const Position& position, std::vector<UnitSlot>& buffer) const
+        {
+            return getUnitsInRange(position, ADJACENT_RANGE, buffer);
+        }
+
+        // Whether any unit other than the one standing on the position occupies a neighbouring cell
+        bool hasAdjacentUnits(const Position& position) const
+        {
+            return _map.getOccupiedNeighbours(position) != 0;
+        }
+
+        // Random numbers for a unit's turn in the current tick
+        RandomStream getRandomStream(UnitSlot slot) const
+        {
+            return RandomStream(_options.seed, _currentTick, _units.getId(slot));
+        }
+
+        std::optional<UnitSlot> getRandomUnit(std::span<const UnitSlot> units, RandomStream& random) const
         {
             if (units.empty())
             {
-                return nullptr;
+                return std::nullopt;
             }
-            
-            std::uniform_int_distribution<size_t> dist(0, units.size() - 1);
-            return units[dist(_randomEngine)];
+
+            return units[random.nextBelow(units.size())];
         }
 
-        void runSimulation()
+        // Picks a random unit within [minRange, maxRange] of the center that passes the filter.
+        // Each candidate is visited once and no candidate list is built (reservoir sampling).
+        template <typename TFilter>
+        std::optional<UnitSlot> getRandomUnitInAnnulus(const Position& center, double minRange, double maxRange,
+            RandomStream& random, TFilter&& filter) const
         {
-            bool hasActiveUnits = true;
-            uint64_t ticksWithoutChanges = 0;
-            uint64_t previousActiveCount = 0;
-            
-            while (hasActiveUnits && _units.size() > 1 && _currentTick < MAX_TICKS)
+            std::optional<UnitSlot> chosen;
+            size_t candidates = 0;
+            forEachUnitInAnnulus(center, minRange, maxRange, [&](UnitSlot slot)
             {
-                // Process each unit's action in order of ID
-                std::vector<int32_t> unitIds;
-                for (const auto& [id, _] : _units)
+                if (!filter(slot))
                 {
-                    unitIds.push_back(id);
+                    return;
                 }
-                
-                std::sort(unitIds.begin(), unitIds.end());
-                
-                for (int32_t id : unitIds)
+
+                ++candidates;
+                if (candidates == 1 || random.nextBelow(candidates) == 0)
                 {
-                    auto unit = getUnit(id);
-                    if (unit && unit->isActive())
-                    {
-                        unit->performAction(*this);
-                    }
+                    chosen = slot;
                 }
-                
-                // Remove dead units
-                std::vector<int32_t> deadUnits;
-                for (const auto& [id, unit] : _units)
+            });
+            return chosen;
+        }
+
+        std::optional<UnitSlot> getRandomUnitInAnnulus(const Position& center, double minRange, double maxRange, RandomStream& random) const
+        {
+            return getRandomUnitInAnnulus(center, minRange, maxRange, random, [](UnitSlot) { return true; });
+        }
+
+        // Picks a random unit in one of the eight cells around the position
+        std::optional<UnitSlot> getRandomAdjacentUnit(const Position& position, RandomStream& random) const
+        {
+            uint8_t occupied = _map.getOccupiedNeighbours(position);
+            if (Profiler* profiler = getProfiler())
+            {
+                profiler->count(ProfileCounter::RangeQueries);
+                profiler->count(ProfileCounter::CandidatesExamined, std::popcount(occupied));
+            }
+            if (occupied == 0)
+            {
+                return std::nullopt;
+            }
+
+            const int count = std::popcount(occupied);
+            int pick = count == 1 ? 0 : static_cast<int>(random.nextBelow(count));
+            for (; pick > 0; --pick)
+            {
+                occupied &= occupied - 1;
+            }
+
+            return _map.getUnitAt(position + Map::NEIGHBOUR_OFFSETS[std::countr_zero(occupied)]);
+        }
+
+        // Works out the unit's turn according to its type. Only reads the state.
+        UnitAction decideAction(UnitSlot slot)
+        {
+            RandomStream random = getRandomStream(slot);
+            return visitUnitType(_units.getType(slot), [this, slot, &random]<typename TUnit>(std::type_identity<TUnit>)
+            {
+                return TUnit(_units, slot).decideAction(*this, random);
+            });
+        }
+
+        void performAction(UnitSlot slot)
+        {
+            const UnitAction action = decideAction(slot);
+            Unit(_units, slot).apply(*this, action);
+            settle(slot, action);
+        }
+
+        // Every active unit that is awake takes its turn, in creation order. Sleeping units would
+        // have done nothing, so skipping them changes nothing.
+        void runTurns()
+        {
+            if (_options.threadPool && _turnQueue.getAwakeCount() >= PARALLEL_MIN_UNITS)
+            {
+                runTurnsInParallel();
+                return;
+            }
+
+            Profiler* profiler = getProfiler();
+            for (UnitSlot slot = _turnQueue.nextAwake(0); slot != TurnQueue::END; slot = _turnQueue.nextAwake(slot + 1))
+            {
+                if (!_units.isActive(slot))
                 {
-                    if (!unit->isActive())
+                    continue;
+                }
+
+                if (profiler)
+                {
+                    UnitAction action;
                     {
-                        deadUnits.push_back(id);
+                        ProfileScope scope(profiler, ProfilePhase::Decide);
+                        action = decideAction(slot);
                     }
+                    ProfileScope scope(profiler, ProfilePhase::Apply);
+                    Unit(_units, slot).apply(*this, action);
+                    settle(slot, action);
                 }
-                
-                for (int32_t id : deadUnits)
+                else
                 {
-                    logEvent(io::UnitDied{static_cast<uint32_t>(id)});
-                    removeUnit(id);
+                    performAction(slot);
                 }
-                
-                // Check if we still have active units
-                hasActiveUnits = false;
-                uint64_t currentActiveCount = 0;
-                for (const auto& [_, unit] : _units)
+            }
+        }
+
+        // Decides all actions in parallel from the state at the start of the tick, then applies them
+        // in creation order. A unit whose decision read a cell that an earlier move this tick changed
+        // decides again, so the outcome is the same as taking the turns one by one.
+        void runTurnsInParallel()
+        {
+            if (_movedCells.isSparse() != _map.isSparse())
+            {
+                // An Auto map turned dense as units were spawned
+                _movedCells.reset(_map.getWidth(), _map.getHeight(), _map.isSparse());
+            }
+
+            _plannedSlots.clear();
+            for (UnitSlot slot = _turnQueue.nextAwake(0); slot != TurnQueue::END; slot = _turnQueue.nextAwake(slot + 1))
+            {
+                _plannedSlots.push_back(slot);
+            }
+
+            const size_t count = _plannedSlots.size();
+            _plannedActions.resize(count);
+            {
+                ProfileScope decideScope(getProfiler(), ProfilePhase::Decide);
+                _options.threadPool->parallelFor(count, PARALLEL_CHUNK, [this](size_t begin, size_t end)
                 {
-                    if (unit->isActive())
+                    for (size_t i = begin; i < end; ++i)
                     {
-                        hasActiveUnits = true;
-                        currentActiveCount++;
+                        const UnitSlot slot = _plannedSlots[i];
+                        if (_units.isActive(slot))
+                        {
+                            _plannedActions[i] = decideAction(slot);
+                        }
                     }
+                });
+            }
+
+            ProfileScope applyScope(getProfiler(), ProfilePhase::Apply);
+            _trackMoves = true;
+            size_t planned = 0;
+            for (UnitSlot slot = _turnQueue.nextAwake(0); slot != TurnQueue::END; slot = _turnQueue.nextAwake(slot + 1))
+            {
+                while (planned < count && _plannedSlots[planned] < slot)
+                {
+                    ++planned;
                 }
+                if (!_units.isActive(slot))
+                {
+                    continue; // Killed earlier in this tick
+                }
+
+                // Units woken by an earlier turn of this tick have no plan and decide now
+                UnitAction action;
+                if (planned < count && _plannedSlots[planned] == slot
+                    && !_movedCells.intersectsSquare(_units.getPosition(slot), _plannedActions[planned].reach))
+                {
+                    action = _plannedActions[planned];
+                }
+                else
+                {
+                    action = decideAction(slot);
+                }
+                Unit(_units, slot).apply(*this, action);
+                settle(slot, action);
+            }
+            _trackMoves = false;
+            _movedCells.clear();
+        }
+
+        // Removes the units that died during this tick. Costs O(deaths), not O(units).
+        void removeDeadUnits()
+        {
+            const auto& dead = _units.getDeadUnits();
+            for (size_t i = 0; i < dead.size(); ++i)
+            {
+                const UnitSlot slot = dead[i];
+                if (_units.isRemoved(slot) || _units.getHp(slot) > 0)
+                {
+                    continue;
+                }
+
+                logEvent([this, slot] { return io::UnitDied{static_cast<uint32_t>(_units.getId(slot))}; });
+                count(ProfileCounter::Deaths);
+                removeUnitAt(slot);
+            }
+            _units.clearDeadUnits();
+        }
+
+        // Plays the current tick: paths, turns and the removal of the dead. Returns the number of
+        // units still active. Does not advance the tick counter.
+        uint64_t runTick()
+        {
+            Profiler* profiler = getProfiler();
+            if (profiler)
+            {
+                profiler->beginTick(_currentTick);
+            }
+
+            {
+                ProfileScope scope(profiler, ProfilePhase::Paths);
+                _pathPlanner.update(_map, _units);
+            }
+
+            reserveSleeperBlocks();
+            runTurns();
+
+            {
+                ProfileScope scope(profiler, ProfilePhase::Cleanup);
+                removeDeadUnits();
+            }
+
+            const uint64_t activeCount = _units.getActiveCount();
+            if (profiler)
+            {
+                profiler->endTick(activeCount);
+            }
+            return activeCount;
+        }
+
+        void runSimulation()
+        {
+            runSimulation([](uint64_t) { return false; });
+        }
+
+        // takeCommands(tick) applies the scripted commands due at the start of a tick and returns
+        // whether more are to come. The battle goes on while any are, even with no unit left to act.
+        template <typename TTakeCommands>
+        void runSimulation(TTakeCommands&& takeCommands)
+        {
+            bool hasActiveUnits = true;
+            bool commandsPending = takeCommands(_currentTick);
+            
+            while ((commandsPending || (hasActiveUnits && _units.size() > 1)) && _currentTick < MAX_TICKS)
+            {
+                // Check if we still have active units
+                const uint64_t currentActiveCount = runTick();
+                hasActiveUnits = currentActiveCount > 0;
                 
                 // Check for "hanging" - if the number of active units does not change for 50 ticks,
                 // then the units are probably unable to reach their targets or are in an infinite loop
-                if (currentActiveCount == previousActiveCount)
+                if (currentActiveCount == _previousActiveCount && !commandsPending)
                 {
-                    ticksWithoutChanges++;
-                    if (ticksWithoutChanges >= 50)
+                    _ticksWithoutChanges++;
+                    if (_ticksWithoutChanges >= 50)
                     {
                         break; // Exit the loop if the simulation is "stuck"
                     }
                 }
                 else
                 {
-                    ticksWithoutChanges = 0;
-                    previousActiveCount = currentActiveCount;
+                    _ticksWithoutChanges = 0;
+                    _previousActiveCount = currentActiveCount;
                 }
                 
                 // Move to next tick if we have active units
-                if (hasActiveUnits && _units.size() > 1)
+                if (commandsPending || (hasActiveUnits && _units.size() > 1))
                 {
                     nextTick();
+                    if (commandsPending)
+                    {
+                        commandsPending = takeCommands(_currentTick);
+                        hasActiveUnits = _units.getActiveCount() > 0;
+                    }
+                    if (_options.snapshots)
+                    {
+                        _options.snapshots->onTickStart(*this);
+                    }
                 }
             }
         }
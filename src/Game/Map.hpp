@@ -1,31 +1,87 @@
 #pragma once
 
+#include "FlatCellMap.hpp"
 #include "Position.hpp"
+#include "Units/UnitSlot.hpp"
+#include <array>
+#include <bit>
 #include <vector>
 #include <optional>
+#include <span>
 #include <stdexcept>
+#include <utility>
 
 namespace sw::game
 {
+    // Occupancy of the battlefield.
+    // Dense maps keep a slot per cell plus a bitset of whole rows. Sparse maps, meant for huge and
+    // mostly empty battlefields, keep only the non-zero words of that bitset and the slots of the
+    // occupied cells in hash tables, so their memory grows with the units rather than the area.
+    // An Auto map that starts sparse turns dense once its units fill enough of it.
+    // Both read the bitset a word at a time through rowWord(), so every query works on either.
     class Map
     {
+    public:
+        enum class Storage
+        {
+            Auto,  // Sparse from SPARSE_MIN_CELLS cells up while fewer than one cell in DENSE_CELLS_PER_UNIT is occupied
+            Dense,
+            Sparse
+        };
+
+        // Smaller maps are dense from the start. A dense map this large would take a quarter of a
+        // gigabyte for the slots alone, while below it the hash lookups cost more than memory saves.
+        static constexpr uint64_t SPARSE_MIN_CELLS = uint64_t{1} << 26;
+
+        // Past this occupancy the hash tables take about as much memory as the dense arrays and are
+        // slower to read, so an Auto map switches. It never switches back.
+        static constexpr uint64_t DENSE_CELLS_PER_UNIT = 16;
+
+        // Offsets of the eight neighbouring cells, row by row.
+        // Bit i of a neighbour mask refers to NEIGHBOUR_OFFSETS[i].
+        static constexpr std::array<Position, 8> NEIGHBOUR_OFFSETS{{
+            {-1, -1}, {0, -1}, {1, -1},
+            {-1, 0}, {1, 0},
+            {-1, 1}, {0, 1}, {1, 1}
+        }};
+
     private:
+        static constexpr UnitSlot EMPTY_CELL = ~UnitSlot{0};
+
         int32_t _width;
         int32_t _height;
-        std::vector<std::optional<int32_t>> _grid; // Stores unit IDs
+        size_t _wordsPerRow;
+        bool _sparse;
+        bool _autoStorage;                // Sparse for now, dense once occupied enough
+        std::vector<UnitSlot> _cells;     // Storage slot of the unit in each cell, EMPTY_CELL if free
+        std::vector<uint64_t> _occupancy; // One bit per cell, every row padded to whole words
+
+        // Sparse storage: the non-zero words of the occupancy bitset and the slots of occupied cells
+        FlatCellMap<uint64_t> _sparseWords;
+        FlatCellMap<UnitSlot> _sparseCells;
 
     public:
-        Map(int32_t width, int32_t height)
-            : _width(width), _height(height), _grid(width * height, std::nullopt)
+        Map(int32_t width, int32_t height, Storage storage = Storage::Auto)
+            : _width(width), _height(height), _wordsPerRow(0), _sparse(false), _autoStorage(false)
         {
             if (width <= 0 || height <= 0)
             {
                 throw std::invalid_argument("Map dimensions must be positive");
             }
+
+            const uint64_t area = static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
+            _autoStorage = storage == Storage::Auto && area >= SPARSE_MIN_CELLS;
+            _sparse = storage == Storage::Sparse || _autoStorage;
+            _wordsPerRow = (static_cast<size_t>(width) + 63) / 64;
+            if (!_sparse)
+            {
+                allocateDense();
+            }
         }
 
         int32_t getWidth() const { return _width; }
         int32_t getHeight() const { return _height; }
+        bool isSparse() const { return _sparse; }
 
         bool isValidPosition(const Position& pos) const
         {
@@ -38,25 +94,30 @@ namespace sw::game
             {
                 return true; // Treat out-of-bounds as occupied
             }
-            return _grid[pos.y * _width + pos.x].has_value();
+            return testBit(pos);
         }
 
-        std::optional<int32_t> getUnitIdAt(const Position& pos) const
+        std::optional<UnitSlot> getUnitAt(const Position& pos) const
         {
-            if (!isValidPosition(pos))
+            if (!isValidPosition(pos) || !testBit(pos))
             {
                 return std::nullopt;
             }
-            return _grid[pos.y * _width + pos.x];
+            return slotAt(pos);
         }
 
-        bool placeUnit(const Position& pos, int32_t unitId)
+        bool placeUnit(const Position& pos, UnitSlot slot)
         {
             if (!isValidPosition(pos) || isOccupied(pos))
             {
                 return false;
             }
-            _grid[pos.y * _width + pos.x] = unitId;
+            setSlot(pos, slot);
+            setBit(pos);
+            if (_autoStorage && _sparseCells.size() * DENSE_CELLS_PER_UNIT >= getArea())
+            {
+                makeDense();
+            }
             return true;
         }
 
@@ -66,48 +127,249 @@ namespace sw::game
             {
                 return false;
             }
-            _grid[pos.y * _width + pos.x] = std::nullopt;
+            clearSlot(pos);
+            clearBit(pos);
             return true;
         }
 
         bool moveUnit(const Position& from, const Position& to)
         {
-            if (!isValidPosition(from) || !isValidPosition(to) || isOccupied(to))
+            if (!isValidPosition(from) || !isValidPosition(to) || isOccupied(to) || !isOccupied(from))
             {
                 return false;
             }
 
-            auto unitId = getUnitIdAt(from);
-            if (!unitId)
+            if (!_sparse)
             {
-                return false;
+                std::swap(_cells[cellIndex(to)], _cells[cellIndex(from)]);
+                _occupancy[static_cast<size_t>(from.y) * _wordsPerRow + static_cast<size_t>(from.x) / 64] &= ~(uint64_t{1} << (from.x % 64));
+                _occupancy[static_cast<size_t>(to.y) * _wordsPerRow + static_cast<size_t>(to.x) / 64] |= uint64_t{1} << (to.x % 64);
+                return true;
             }
 
-            _grid[from.y * _width + from.x] = std::nullopt;
-            _grid[to.y * _width + to.x] = unitId;
+            setSlot(to, slotAt(from));
+            clearSlot(from);
+            clearBit(from);
+            setBit(to);
             return true;
         }
 
-        std::vector<Position> getAdjacentPositions(const Position& pos) const
+        // Mask of the neighbouring cells (see NEIGHBOUR_OFFSETS) that are inside the map and occupied.
+        // Built from three word reads of the occupancy bitset.
+        uint8_t getOccupiedNeighbours(const Position& pos) const
+        {
+            return packNeighbours(occupiedTriple(pos.y - 1, pos.x), occupiedTriple(pos.y, pos.x), occupiedTriple(pos.y + 1, pos.x));
+        }
+
+        // Mask of the neighbouring cells (see NEIGHBOUR_OFFSETS) that are inside the map and free
+        uint8_t getFreeNeighbours(const Position& pos) const
+        {
+            return getInsideNeighbours(pos) & ~getOccupiedNeighbours(pos);
+        }
+
+        // Calls callback(slot, position) for every occupied cell in row y between x0 and x1 inclusive.
+        // The span must lie inside the map. Empty stretches are skipped a whole word at a time.
+        template <typename TCallback>
+        void forEachUnitInRow(int32_t y, int32_t x0, int32_t x1, TCallback&& callback) const
+        {
+            const size_t firstWord = static_cast<size_t>(x0) / 64;
+            const size_t lastWord = static_cast<size_t>(x1) / 64;
+
+            for (size_t word = firstWord; word <= lastWord; ++word)
+            {
+                uint64_t bits = rowWord(y, word);
+                if (word == firstWord)
+                {
+                    bits &= ~uint64_t{0} << (x0 % 64);
+                }
+                if (word == lastWord && x1 % 64 != 63)
+                {
+                    bits &= (uint64_t{1} << (x1 % 64 + 1)) - 1;
+                }
+
+                while (bits != 0)
+                {
+                    const int32_t x = static_cast<int32_t>(word * 64) + std::countr_zero(bits);
+                    bits &= bits - 1;
+                    const Position position(x, y);
+                    callback(slotAt(position), position);
+                }
+            }
+        }
+
+        // Neighbouring cells inside the map, written to the front of the buffer
+        std::span<const Position> getAdjacentPositions(const Position& pos, std::array<Position, 8>& buffer) const
         {
-            std::vector<Position> result;
-            for (int32_t dy = -1; dy <= 1; ++dy)
+            size_t count = 0;
+            const uint8_t inside = getInsideNeighbours(pos);
+            for (size_t i = 0; i < NEIGHBOUR_OFFSETS.size(); ++i)
             {
-                for (int32_t dx = -1; dx <= 1; ++dx)
+                if (inside & (1u << i))
                 {
-                    if (dx == 0 && dy == 0)
-                    {
-                        continue;
-                    }
-                    
-                    Position adjacent(pos.x + dx, pos.y + dy);
-                    if (isValidPosition(adjacent))
-                    {
-                        result.push_back(adjacent);
-                    }
+                    buffer[count++] = pos + NEIGHBOUR_OFFSETS[i];
                 }
             }
-            return result;
+            return std::span<const Position>(buffer.data(), count);
+        }
+
+    private:
+        uint64_t getArea() const { return static_cast<uint64_t>(_width) * static_cast<uint64_t>(_height); }
+
+        void allocateDense()
+        {
+            _cells.assign(static_cast<size_t>(getArea()), EMPTY_CELL);
+            _occupancy.assign(_wordsPerRow * static_cast<size_t>(_height), 0);
+        }
+
+        // Moves the occupied cells out of the hash tables into dense arrays and frees the tables
+        void makeDense()
+        {
+            allocateDense();
+            _sparseCells.forEach([this](uint64_t key, UnitSlot slot)
+            {
+                _cells[cellIndex(Position(static_cast<int32_t>(key & 0xFFFFFFFF), static_cast<int32_t>(key >> 32)))] = slot;
+            });
+            _sparseWords.forEach([this](uint64_t key, uint64_t bits)
+            {
+                _occupancy[static_cast<size_t>(key >> 32) * _wordsPerRow + static_cast<size_t>(key & 0xFFFFFFFF)] = bits;
+            });
+            _sparseCells = {};
+            _sparseWords = {};
+            _sparse = false;
+            _autoStorage = false;
+        }
+
+        size_t cellIndex(const Position& pos) const
+        {
+            return static_cast<size_t>(pos.y) * static_cast<size_t>(_width) + static_cast<size_t>(pos.x);
+        }
+
+        static uint64_t cellKey(const Position& pos)
+        {
+            return static_cast<uint64_t>(static_cast<uint32_t>(pos.y)) << 32 | static_cast<uint32_t>(pos.x);
+        }
+
+        static uint64_t wordKey(int32_t y, size_t word)
+        {
+            return static_cast<uint64_t>(static_cast<uint32_t>(y)) << 32 | word;
+        }
+
+        // Occupancy of cells word * 64 .. word * 64 + 63 of row y
+        uint64_t rowWord(int32_t y, size_t word) const
+        {
+            if (!_sparse)
+            {
+                return _occupancy[static_cast<size_t>(y) * _wordsPerRow + word];
+            }
+
+            const uint64_t* bits = _sparseWords.find(wordKey(y, word));
+            return bits ? *bits : 0;
+        }
+
+        UnitSlot slotAt(const Position& pos) const
+        {
+            return _sparse ? *_sparseCells.find(cellKey(pos)) : _cells[cellIndex(pos)];
+        }
+
+        void setSlot(const Position& pos, UnitSlot slot)
+        {
+            if (_sparse)
+            {
+                _sparseCells[cellKey(pos)] = slot;
+            }
+            else
+            {
+                _cells[cellIndex(pos)] = slot;
+            }
+        }
+
+        void clearSlot(const Position& pos)
+        {
+            if (_sparse)
+            {
+                _sparseCells.erase(cellKey(pos));
+            }
+            else
+            {
+                _cells[cellIndex(pos)] = EMPTY_CELL;
+            }
+        }
+
+        bool testBit(const Position& pos) const
+        {
+            return (rowWord(pos.y, static_cast<size_t>(pos.x) / 64) >> (pos.x % 64)) & 1;
+        }
+
+        void setBit(const Position& pos)
+        {
+            const uint64_t bit = uint64_t{1} << (pos.x % 64);
+            const size_t word = static_cast<size_t>(pos.x) / 64;
+            if (_sparse)
+            {
+                _sparseWords[wordKey(pos.y, word)] |= bit;
+            }
+            else
+            {
+                _occupancy[static_cast<size_t>(pos.y) * _wordsPerRow + word] |= bit;
+            }
+        }
+
+        void clearBit(const Position& pos)
+        {
+            const uint64_t bit = uint64_t{1} << (pos.x % 64);
+            const size_t word = static_cast<size_t>(pos.x) / 64;
+            if (!_sparse)
+            {
+                _occupancy[static_cast<size_t>(pos.y) * _wordsPerRow + word] &= ~bit;
+                return;
+            }
+
+            // Words that empty out are dropped, so memory follows the units
+            const uint64_t key = wordKey(pos.y, word);
+            uint64_t* bits = _sparseWords.find(key);
+            if (bits && (*bits &= ~bit) == 0)
+            {
+                _sparseWords.erase(key);
+            }
+        }
+
+        // Occupancy of cells x-1, x, x+1 of row y as bits 0..2. Cells outside the map read as free.
+        // Padding bits past the map width are never set, so x+1 == width needs no special case.
+        uint32_t occupiedTriple(int32_t y, int32_t x) const
+        {
+            if (y < 0 || y >= _height)
+            {
+                return 0;
+            }
+
+            if (x == 0)
+            {
+                return static_cast<uint32_t>(rowWord(y, 0) << 1) & 0b111;
+            }
+
+            const size_t start = static_cast<size_t>(x - 1);
+            const size_t word = start / 64;
+            const uint32_t offset = start % 64;
+            uint64_t bits = rowWord(y, word) >> offset;
+            if (offset > 61 && word + 1 < _wordsPerRow)
+            {
+                bits |= rowWord(y, word + 1) << (64 - offset);
+            }
+            return static_cast<uint32_t>(bits) & 0b111;
+        }
+
+        uint8_t getInsideNeighbours(const Position& pos) const
+        {
+            const uint32_t columns = (pos.x > 0 ? 0b001u : 0u) | 0b010u | (pos.x + 1 < _width ? 0b100u : 0u);
+            const uint32_t top = pos.y > 0 ? columns : 0u;
+            const uint32_t bottom = pos.y + 1 < _height ? columns : 0u;
+            return packNeighbours(top, columns, bottom);
+        }
+
+        // Combines three 3-bit row windows into a neighbour mask, dropping the centre cell
+        static uint8_t packNeighbours(uint32_t top, uint32_t middle, uint32_t bottom)
+        {
+            return static_cast<uint8_t>(top | (middle & 0b001u) << 3 | (middle & 0b100u) << 2 | bottom << 5);
         }
     };
-} 
\ No newline at end of file
+}
@@ -0,0 +1,110 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace sw::game
+{
+    ThreadPool::ThreadPool(size_t threadCount)
+    {
+        if (threadCount == 0)
+        {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        _workers.reserve(threadCount - 1);
+        for (size_t i = 1; i < threadCount; ++i)
+        {
+            _workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _stopping = true;
+        }
+        _jobReady.notify_all();
+        for (auto& worker : _workers)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::run(size_t count, size_t chunkSize, void* body, void (*invoke)(void*, size_t, size_t))
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _job.invoke = invoke;
+            _job.body = body;
+            _job.count = count;
+            _job.chunkSize = std::max<size_t>(chunkSize, 1);
+            _job.nextIndex.store(0, std::memory_order_relaxed);
+            _busyWorkers = _workers.size();
+            _error = nullptr;
+            ++_generation;
+        }
+        _jobReady.notify_all();
+
+        workOnJob();
+
+        std::unique_lock lock(_mutex);
+        _jobDone.wait(lock, [this] { return _busyWorkers == 0; });
+        if (_error)
+        {
+            std::rethrow_exception(std::exchange(_error, nullptr));
+        }
+    }
+
+    void ThreadPool::workOnJob()
+    {
+        try
+        {
+            while (true)
+            {
+                const size_t begin = _job.nextIndex.fetch_add(_job.chunkSize, std::memory_order_relaxed);
+                if (begin >= _job.count)
+                {
+                    break;
+                }
+                _job.invoke(_job.body, begin, std::min(begin + _job.chunkSize, _job.count));
+            }
+        }
+        catch (...)
+        {
+            // Stop handing out chunks and report the first failure to the caller
+            _job.nextIndex.store(_job.count, std::memory_order_relaxed);
+            std::lock_guard lock(_mutex);
+            if (!_error)
+            {
+                _error = std::current_exception();
+            }
+        }
+    }
+
+    void ThreadPool::workerLoop()
+    {
+        uint64_t seenGeneration = 0;
+        while (true)
+        {
+            {
+                std::unique_lock lock(_mutex);
+                _jobReady.wait(lock, [this, seenGeneration] { return _stopping || _generation != seenGeneration; });
+                if (_stopping)
+                {
+                    return;
+                }
+                seenGeneration = _generation;
+            }
+
+            workOnJob();
+
+            std::lock_guard lock(_mutex);
+            if (--_busyWorkers == 0)
+            {
+                _jobDone.notify_one();
+            }
+        }
+    }
+}
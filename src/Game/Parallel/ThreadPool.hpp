@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace sw::game
+{
+    // Fixed set of worker threads for data-parallel loops.
+    // parallelFor() splits a range into chunks that the threads claim from a shared counter, so
+    // threads that finish early keep taking work from the rest. The calling thread joins in.
+    class ThreadPool
+    {
+    private:
+        struct Job
+        {
+            void (*invoke)(void* body, size_t begin, size_t end) = nullptr;
+            void* body = nullptr;
+            size_t count = 0;
+            size_t chunkSize = 1;
+            std::atomic<size_t> nextIndex{0};
+        };
+
+        std::vector<std::thread> _workers;
+        Job _job;
+        std::mutex _mutex;
+        std::condition_variable _jobReady;
+        std::condition_variable _jobDone;
+        uint64_t _generation = 0;
+        size_t _busyWorkers = 0;
+        bool _stopping = false;
+        std::exception_ptr _error;
+
+    public:
+        // threadCount includes the calling thread; 0 means one per hardware thread
+        explicit ThreadPool(size_t threadCount);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        size_t getThreadCount() const { return _workers.size() + 1; }
+
+        // Calls body(begin, end) for consecutive chunks covering [0, count) and returns once all
+        // of them are done. The first exception thrown by a chunk is rethrown here.
+        template <typename TBody>
+        void parallelFor(size_t count, size_t chunkSize, TBody&& body)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+
+            if (_workers.empty() || count <= chunkSize)
+            {
+                body(size_t{0}, count);
+                return;
+            }
+
+            run(count, chunkSize, &body, [](void* context, size_t begin, size_t end)
+            {
+                (*static_cast<std::remove_reference_t<TBody>*>(context))(begin, end);
+            });
+        }
+
+    private:
+        void run(size_t count, size_t chunkSize, void* body, void (*invoke)(void*, size_t, size_t));
+        void workOnJob();
+        void workerLoop();
+    };
+}
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "../Map.hpp"
+#include "../Position.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace sw::game
+{
+    // Distance field towards one march target over a rectangular window of the map.
+    // Each cell holds the number of 8-directional steps to the target around blocked cells,
+    // so every unit marching to that target can read its next step instead of searching.
+    class FlowField
+    {
+    public:
+        static constexpr uint32_t UNREACHABLE = ~uint32_t{0};
+
+        // Work lists for computing and repairing fields. They are empty between calls, so one
+        // Scratch can serve every field and keeps its capacity from one update to the next.
+        struct Scratch
+        {
+            std::vector<size_t> queue;       // Cells whose neighbours are to be relaxed
+            std::vector<size_t> invalidated; // Cells cut off by a newly blocked cell
+        };
+
+    private:
+        Position _target;
+        Position _origin; // Top-left cell of the window
+        int32_t _width = 0;
+        int32_t _height = 0;
+        std::vector<uint32_t> _distances;
+        std::vector<uint8_t> _blocked;
+
+    public:
+        const Position& getTarget() const { return _target; }
+        const Position& getOrigin() const { return _origin; }
+        int32_t getWidth() const { return _width; }
+        int32_t getHeight() const { return _height; }
+
+        bool contains(const Position& pos) const
+        {
+            return pos.x >= _origin.x && pos.x < _origin.x + _width && pos.y >= _origin.y && pos.y < _origin.y + _height;
+        }
+
+        uint32_t getDistance(const Position& pos) const
+        {
+            return contains(pos) ? _distances[indexOf(pos)] : UNREACHABLE;
+        }
+
+        // Starts a new field with every cell of the window walkable.
+        // Call block() for the obstacles and then computeDistances().
+        void reset(const Position& target, const Position& origin, int32_t width, int32_t height)
+        {
+            _target = target;
+            _origin = origin;
+            _width = width;
+            _height = height;
+            const size_t size = static_cast<size_t>(width) * static_cast<size_t>(height);
+            if (size < _distances.capacity() / 2)
+            {
+                // Give back the memory of a much larger window; similar sizes keep reusing it
+                std::vector<uint32_t>().swap(_distances);
+                std::vector<uint8_t>().swap(_blocked);
+            }
+            _distances.assign(size, UNREACHABLE);
+            _blocked.assign(size, 0);
+        }
+
+        void block(const Position& pos)
+        {
+            if (contains(pos) && pos != _target)
+            {
+                _blocked[indexOf(pos)] = 1;
+            }
+        }
+
+        void computeDistances(Scratch& scratch)
+        {
+            std::fill(_distances.begin(), _distances.end(), UNREACHABLE);
+            scratch.queue.clear();
+            if (contains(_target))
+            {
+                const size_t target = indexOf(_target);
+                _distances[target] = 0;
+                scratch.queue.push_back(target);
+            }
+            propagate(scratch.queue);
+        }
+
+        // Repairs the field after one cell became blocked or walkable, touching only
+        // the cells whose distance actually changes
+        void setBlocked(const Position& pos, bool blocked, Scratch& scratch)
+        {
+            if (!contains(pos) || pos == _target)
+            {
+                return;
+            }
+
+            const size_t index = indexOf(pos);
+            if ((_blocked[index] != 0) == blocked)
+            {
+                return;
+            }
+
+            _blocked[index] = blocked ? 1 : 0;
+            scratch.queue.clear();
+            if (blocked)
+            {
+                raise(index, scratch);
+            }
+            else
+            {
+                seed(index, scratch.queue);
+            }
+            propagate(scratch.queue);
+        }
+
+    private:
+        size_t indexOf(const Position& pos) const
+        {
+            return static_cast<size_t>(pos.y - _origin.y) * static_cast<size_t>(_width) + static_cast<size_t>(pos.x - _origin.x);
+        }
+
+        Position positionOf(size_t index) const
+        {
+            return Position(_origin.x + static_cast<int32_t>(index % _width), _origin.y + static_cast<int32_t>(index / _width));
+        }
+
+        // Calls callback(index) for every neighbour of the cell that lies inside the window
+        template <typename TCallback>
+        void forEachNeighbour(size_t index, TCallback&& callback) const
+        {
+            const Position pos = positionOf(index);
+            for (const auto& offset : Map::NEIGHBOUR_OFFSETS)
+            {
+                const Position neighbour = pos + offset;
+                if (contains(neighbour))
+                {
+                    callback(indexOf(neighbour));
+                }
+            }
+        }
+
+        // Gives a walkable cell the best distance offered by its neighbours and queues it
+        void seed(size_t index, std::vector<size_t>& queue)
+        {
+            uint32_t best = UNREACHABLE;
+            forEachNeighbour(index, [this, &best](size_t neighbour)
+            {
+                if (_distances[neighbour] != UNREACHABLE)
+                {
+                    best = std::min(best, _distances[neighbour] + 1);
+                }
+            });
+
+            if (best < _distances[index])
+            {
+                _distances[index] = best;
+                queue.push_back(index);
+            }
+        }
+
+        // Invalidates every cell whose shortest path ran through the newly blocked cell,
+        // layer by layer, then re-seeds them from the surviving cells around them
+        void raise(size_t index, Scratch& scratch)
+        {
+            const uint32_t distance = _distances[index];
+            _distances[index] = UNREACHABLE;
+            if (distance == UNREACHABLE)
+            {
+                return;
+            }
+
+            scratch.invalidated.clear();
+            std::vector<size_t>& layer = scratch.queue;
+            forEachNeighbour(index, [this, &layer, distance](size_t neighbour)
+            {
+                if (_distances[neighbour] == distance + 1)
+                {
+                    layer.push_back(neighbour);
+                }
+            });
+
+            for (size_t i = 0; i < layer.size(); ++i)
+            {
+                const size_t cell = layer[i];
+                const uint32_t cellDistance = _distances[cell];
+                if (cellDistance == UNREACHABLE)
+                {
+                    continue;
+                }
+
+                bool supported = false;
+                forEachNeighbour(cell, [this, &supported, cellDistance](size_t neighbour)
+                {
+                    supported = supported || _distances[neighbour] + 1 == cellDistance;
+                });
+                if (supported)
+                {
+                    continue;
+                }
+
+                _distances[cell] = UNREACHABLE;
+                scratch.invalidated.push_back(cell);
+                forEachNeighbour(cell, [this, &layer, cellDistance](size_t neighbour)
+                {
+                    if (_distances[neighbour] == cellDistance + 1)
+                    {
+                        layer.push_back(neighbour);
+                    }
+                });
+            }
+
+            layer.clear();
+            for (size_t cell : scratch.invalidated)
+            {
+                seed(cell, layer);
+            }
+        }
+
+        // Relaxes distances outwards from the queued cells until nothing improves
+        void propagate(std::vector<size_t>& queue)
+        {
+            for (size_t i = 0; i < queue.size(); ++i)
+            {
+                const size_t cell = queue[i];
+                const uint32_t next = _distances[cell] + 1;
+                forEachNeighbour(cell, [this, &queue, next](size_t neighbour)
+                {
+                    if (_blocked[neighbour] == 0 && next < _distances[neighbour])
+                    {
+                        _distances[neighbour] = next;
+                        queue.push_back(neighbour);
+                    }
+                });
+            }
+            queue.clear();
+        }
+    };
+}
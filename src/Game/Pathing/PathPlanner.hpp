@@ -0,0 +1,330 @@
+#pragma once
+
+#include "FlowField.hpp"
+#include "../Map.hpp"
+#include "../Units/UnitStorage.hpp"
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sw::game
+{
+    // Movement for marching units.
+    // Every marching unit follows the same rule. Within FIELD_RADIUS cells of its target it steps
+    // along the target's FlowField, which covers the square of that radius around the target as
+    // it was at the start of the tick. Further out it takes the free step closest to the target.
+    // Units marching to the same target never block each other's field; every other unit is an
+    // obstacle. A field is only kept while one of its route's units is close enough to read it,
+    // so its cost is bounded by the window whatever the battle looks like, and whether it is
+    // kept never changes a step. Occupancy changes are collected during a tick and applied to the
+    // fields incrementally by update() at the start of the next one. Each field's window is
+    // indexed by the map blocks it covers, so a change only reaches the fields that contain its cell.
+    class PathPlanner
+    {
+    private:
+        struct Route
+        {
+            Position target;
+            FlowField field; // Empty while no member is close enough to read it
+            std::vector<UnitSlot> members;
+            std::vector<std::pair<Position, bool>> changes; // Cells that became blocked (true) or walkable (false)
+        };
+
+    public:
+        static constexpr int32_t FIELD_RADIUS = 32;
+
+    private:
+        static constexpr int32_t WINDOW_BLOCK = 64;
+
+        std::unordered_map<uint64_t, Route> _routes;
+        std::unordered_map<uint64_t, std::vector<Route*>> _windowsByBlock; // Fields whose window covers a block
+        FlowField::Scratch _scratch; // Shared by the fields, which are updated one at a time
+
+    public:
+        PathPlanner() = default;
+
+        PathPlanner(const PathPlanner& other)
+            : _routes(other._routes)
+        {
+            indexWindows();
+        }
+
+        PathPlanner& operator=(const PathPlanner& other)
+        {
+            if (this != &other)
+            {
+                _routes = other._routes;
+                indexWindows();
+            }
+            return *this;
+        }
+
+        PathPlanner(PathPlanner&&) = default;
+        PathPlanner& operator=(PathPlanner&&) = default;
+
+        // Keeps the routes in sync with a unit's march target
+        void onTargetChanged(UnitSlot slot, const Position& position,
+            const std::optional<Position>& oldTarget, const std::optional<Position>& newTarget)
+        {
+            if (oldTarget == newTarget)
+            {
+                return;
+            }
+
+            if (oldTarget)
+            {
+                auto it = _routes.find(keyOf(*oldTarget));
+                if (it != _routes.end())
+                {
+                    auto& members = it->second.members;
+                    members.erase(std::find(members.begin(), members.end(), slot));
+                    if (members.empty())
+                    {
+                        setWindow(it->second, Position(), 0, 0);
+                        _routes.erase(it);
+                    }
+                    else
+                    {
+                        recordChange(it->second, position, true);
+                    }
+                }
+            }
+
+            if (newTarget)
+            {
+                auto [it, inserted] = _routes.try_emplace(keyOf(*newTarget));
+                Route& route = it->second;
+                if (inserted)
+                {
+                    route.target = *newTarget;
+                }
+                route.members.push_back(slot);
+                recordChange(route, position, false);
+            }
+        }
+
+        // Records that a unit marching to unitTarget (if any) left or entered a cell
+        void onCellChanged(const Position& position, bool occupied, const std::optional<Position>& unitTarget)
+        {
+            auto it = _windowsByBlock.find(blockKey(position.x / WINDOW_BLOCK, position.y / WINDOW_BLOCK));
+            if (it == _windowsByBlock.end())
+            {
+                return;
+            }
+
+            for (Route* route : it->second)
+            {
+                if (!unitTarget || *unitTarget != route->target)
+                {
+                    recordChange(*route, position, occupied);
+                }
+            }
+        }
+
+        // Brings every field up to date with the occupancy changes since the previous call. Builds
+        // the fields that a member may read during the coming tick and drops the rest.
+        void update(const Map& map, const UnitStorage& units)
+        {
+            for (auto& [key, route] : _routes)
+            {
+                // A member moves one cell per tick, so one just outside the window may step in
+                const Position& target = route.target;
+                const bool needed = map.isValidPosition(target) && std::any_of(route.members.begin(), route.members.end(),
+                    [&target, &units](UnitSlot slot) { return units.getPosition(slot).chebyshevDistanceTo(target) <= FIELD_RADIUS + 1; });
+                if (!needed)
+                {
+                    setWindow(route, Position(), 0, 0);
+                }
+                else if (areaOf(route.field) == 0 || static_cast<int64_t>(route.changes.size()) * 8 > areaOf(route.field))
+                {
+                    buildField(route, map, units);
+                }
+                else
+                {
+                    for (const auto& [position, blocked] : route.changes)
+                    {
+                        route.field.setBlocked(position, blocked, _scratch);
+                    }
+                }
+                route.changes.clear();
+            }
+        }
+
+        // Picks the next cell for a unit marching from one position to a target.
+        // freeCells is the map's free neighbour mask around the unit. Returns nothing when waiting
+        // is better than stepping away from the target.
+        std::optional<Position> chooseStep(const Position& from, const Position& target, uint8_t freeCells) const
+        {
+            auto it = _routes.find(keyOf(target));
+            if (it != _routes.end() && it->second.field.contains(from))
+            {
+                const FlowField& field = it->second.field;
+                const uint32_t current = field.getDistance(from);
+                if (current != FlowField::UNREACHABLE)
+                {
+                    std::optional<Position> bestMove;
+                    uint32_t bestDistance = FlowField::UNREACHABLE;
+                    int64_t bestDistanceSq = 0;
+                    forEachFreeNeighbour(from, freeCells, [&](const Position& candidate)
+                    {
+                        const uint32_t distance = field.getDistance(candidate);
+                        const int64_t distanceSq = candidate.distanceSqTo(target);
+                        if (distance < bestDistance || (distance == bestDistance && distance != FlowField::UNREACHABLE && distanceSq < bestDistanceSq))
+                        {
+                            bestMove = candidate;
+                            bestDistance = distance;
+                            bestDistanceSq = distanceSq;
+                        }
+                    });
+
+                    if (bestMove)
+                    {
+                        if (bestDistance > current)
+                        {
+                            return std::nullopt; // The way on is held by units marching along
+                        }
+                        return bestMove;
+                    }
+                }
+            }
+
+            return chooseGreedyStep(from, target, freeCells);
+        }
+
+    private:
+        static uint64_t keyOf(const Position& position)
+        {
+            return static_cast<uint64_t>(static_cast<uint32_t>(position.x)) << 32 | static_cast<uint32_t>(position.y);
+        }
+
+        static uint64_t blockKey(int32_t blockX, int32_t blockY)
+        {
+            return keyOf(Position(blockX, blockY));
+        }
+
+        static int64_t areaOf(const FlowField& field)
+        {
+            return int64_t{field.getWidth()} * int64_t{field.getHeight()};
+        }
+
+        // Calls callback(blockKey) for every block the field's window overlaps
+        template <typename TCallback>
+        static void forEachWindowBlock(const FlowField& field, TCallback&& callback)
+        {
+            if (field.getWidth() == 0 || field.getHeight() == 0)
+            {
+                return;
+            }
+
+            const Position& origin = field.getOrigin();
+            const int32_t lastX = (origin.x + field.getWidth() - 1) / WINDOW_BLOCK;
+            const int32_t lastY = (origin.y + field.getHeight() - 1) / WINDOW_BLOCK;
+            for (int32_t y = origin.y / WINDOW_BLOCK; y <= lastY; ++y)
+            {
+                for (int32_t x = origin.x / WINDOW_BLOCK; x <= lastX; ++x)
+                {
+                    callback(blockKey(x, y));
+                }
+            }
+        }
+
+        // Moves a route's field to a new window, empty for none, keeping the block index in step.
+        // The field still has to be filled in.
+        void setWindow(Route& route, const Position& origin, int32_t width, int32_t height)
+        {
+            if (areaOf(route.field) == 0 && (width == 0 || height == 0))
+            {
+                return;
+            }
+
+            Route* routePointer = &route;
+            forEachWindowBlock(route.field, [this, routePointer](uint64_t block)
+            {
+                auto it = _windowsByBlock.find(block);
+                auto& windows = it->second;
+                *std::find(windows.begin(), windows.end(), routePointer) = windows.back();
+                windows.pop_back();
+                if (windows.empty())
+                {
+                    _windowsByBlock.erase(it);
+                }
+            });
+
+            route.field.reset(route.target, origin, width, height);
+
+            forEachWindowBlock(route.field, [this, routePointer](uint64_t block) { _windowsByBlock[block].push_back(routePointer); });
+        }
+
+        // Rebuilds the block index for routes copied from another planner
+        void indexWindows()
+        {
+            _windowsByBlock.clear();
+            for (auto& [key, route] : _routes)
+            {
+                Route* routePointer = &route;
+                forEachWindowBlock(route.field, [this, routePointer](uint64_t block) { _windowsByBlock[block].push_back(routePointer); });
+            }
+        }
+
+        static void recordChange(Route& route, const Position& position, bool blocked)
+        {
+            if (route.field.contains(position))
+            {
+                route.changes.emplace_back(position, blocked);
+            }
+        }
+
+        template <typename TCallback>
+        static void forEachFreeNeighbour(const Position& from, uint8_t freeCells, TCallback&& callback)
+        {
+            for (size_t i = 0; i < Map::NEIGHBOUR_OFFSETS.size(); ++i)
+            {
+                if (freeCells & (1u << i))
+                {
+                    callback(from + Map::NEIGHBOUR_OFFSETS[i]);
+                }
+            }
+        }
+
+        // Straight-line step used when no field covers the unit: the free cell closest to the target
+        static std::optional<Position> chooseGreedyStep(const Position& from, const Position& target, uint8_t freeCells)
+        {
+            std::optional<Position> bestMove;
+            int64_t bestDistanceSq = 0;
+            forEachFreeNeighbour(from, freeCells, [&](const Position& candidate)
+            {
+                const int64_t distanceSq = candidate.distanceSqTo(target);
+                if (!bestMove || distanceSq < bestDistanceSq)
+                {
+                    bestMove = candidate;
+                    bestDistanceSq = distanceSq;
+                }
+            });
+            return bestMove;
+        }
+
+        // Computes a route's field over the square of FIELD_RADIUS around its target, clipped to the
+        // map, every other unit being an obstacle
+        void buildField(Route& route, const Map& map, const UnitStorage& units)
+        {
+            const Position origin(std::max(0, route.target.x - FIELD_RADIUS), std::max(0, route.target.y - FIELD_RADIUS));
+            const int32_t width = std::min(map.getWidth() - 1, route.target.x + FIELD_RADIUS) - origin.x + 1;
+            const int32_t height = std::min(map.getHeight() - 1, route.target.y + FIELD_RADIUS) - origin.y + 1;
+            setWindow(route, origin, width, height);
+            for (int32_t y = origin.y; y < origin.y + height; ++y)
+            {
+                map.forEachUnitInRow(y, origin.x, origin.x + width - 1, [&route, &units](UnitSlot slot, const Position& position)
+                {
+                    const auto& target = units.getTarget(slot);
+                    if (!target || *target != route.target)
+                    {
+                        route.field.block(position);
+                    }
+                });
+            }
+            route.field.computeDistances(_scratch);
+        }
+    };
+}
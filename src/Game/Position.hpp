@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 
@@ -10,8 +11,13 @@ namespace sw::game
         int32_t x;
         int32_t y;
 
-        Position() : x(0), y(0) {}
-        Position(int32_t x, int32_t y) : x(x), y(y) {}
+        constexpr Position() : x(0), y(0) {}
+        constexpr Position(int32_t x, int32_t y) : x(x), y(y) {}
+
+        constexpr Position operator+(const Position& offset) const
+        {
+            return Position(x + offset.x, y + offset.y);
+        }
 
         bool operator==(const Position& other) const
         {
@@ -30,11 +36,23 @@ namespace sw::game
             return std::sqrt(dx * dx + dy * dy);
         }
 
+        int64_t distanceSqTo(const Position& other) const
+        {
+            int64_t dx = x - other.x;
+            int64_t dy = y - other.y;
+            return dx * dx + dy * dy;
+        }
+
         int32_t manhattanDistanceTo(const Position& other) const
         {
             return std::abs(x - other.x) + std::abs(y - other.y);
         }
 
+        int64_t chebyshevDistanceTo(const Position& other) const
+        {
+            return std::max(std::abs(int64_t{x} - other.x), std::abs(int64_t{y} - other.y));
+        }
+
         bool isAdjacent(const Position& other) const
         {
             return std::abs(x - other.x) <= 1 && 
@@ -0,0 +1,129 @@
+#include "Profiler.hpp"
+
+#include <ostream>
+
+namespace sw::game
+{
+    void Profiler::beginTick(uint64_t tick)
+    {
+        _current = TickRecord{};
+        _current.tick = tick;
+        for (auto& counter : _counters)
+        {
+            counter.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void Profiler::endTick(uint64_t activeUnits)
+    {
+        _current.activeUnits = activeUnits;
+        for (size_t i = 0; i < COUNTER_COUNT; ++i)
+        {
+            _current.counters[i] = _counters[i].load(std::memory_order_relaxed);
+        }
+        _ticks.push_back(_current);
+    }
+
+    Profiler::TickRecord Profiler::getTotals() const
+    {
+        TickRecord totals;
+        totals.tick = _ticks.size();
+        for (const auto& record : _ticks)
+        {
+            for (size_t i = 0; i < PHASE_COUNT; ++i)
+            {
+                totals.nanoseconds[i] += record.nanoseconds[i];
+            }
+            for (size_t i = 0; i < COUNTER_COUNT; ++i)
+            {
+                totals.counters[i] += record.counters[i];
+            }
+        }
+        return totals;
+    }
+
+    void Profiler::writeCsv(std::ostream& stream) const
+    {
+        stream << "tick,active_units";
+        for (size_t i = 0; i < PHASE_COUNT; ++i)
+        {
+            stream << ',' << toString(static_cast<ProfilePhase>(i)) << "_ns";
+        }
+        for (size_t i = 0; i < COUNTER_COUNT; ++i)
+        {
+            stream << ',' << toString(static_cast<ProfileCounter>(i));
+        }
+        stream << '\n';
+
+        for (const auto& record : _ticks)
+        {
+            stream << record.tick << ',' << record.activeUnits;
+            for (uint64_t nanoseconds : record.nanoseconds)
+            {
+                stream << ',' << nanoseconds;
+            }
+            for (uint64_t counter : record.counters)
+            {
+                stream << ',' << counter;
+            }
+            stream << '\n';
+        }
+    }
+
+    void Profiler::writeJson(std::ostream& stream) const
+    {
+        auto writeRecord = [&stream](const TickRecord& record, const char* countName)
+        {
+            stream << "{\"" << countName << "\": " << record.tick << ", \"active_units\": " << record.activeUnits;
+            for (size_t i = 0; i < PHASE_COUNT; ++i)
+            {
+                stream << ", \"" << toString(static_cast<ProfilePhase>(i)) << "_ns\": " << record.nanoseconds[i];
+            }
+            for (size_t i = 0; i < COUNTER_COUNT; ++i)
+            {
+                stream << ", \"" << toString(static_cast<ProfileCounter>(i)) << "\": " << record.counters[i];
+            }
+            stream << '}';
+        };
+
+        stream << "{\n  \"totals\": ";
+        writeRecord(getTotals(), "ticks");
+        stream << ",\n  \"ticks\": [";
+        for (size_t i = 0; i < _ticks.size(); ++i)
+        {
+            stream << (i == 0 ? "\n    " : ",\n    ");
+            writeRecord(_ticks[i], "tick");
+        }
+        stream << "\n  ]\n}\n";
+    }
+
+    const char* Profiler::toString(ProfilePhase phase)
+    {
+        switch (phase)
+        {
+            case ProfilePhase::Paths: return "paths";
+            case ProfilePhase::Decide: return "decide";
+            case ProfilePhase::Apply: return "apply";
+            case ProfilePhase::Cleanup: return "cleanup";
+            case ProfilePhase::Count: break;
+        }
+        return "";
+    }
+
+    const char* Profiler::toString(ProfileCounter counter)
+    {
+        switch (counter)
+        {
+            case ProfileCounter::RangeQueries: return "range_queries";
+            case ProfileCounter::CandidatesExamined: return "candidates_examined";
+            case ProfileCounter::MovesAttempted: return "moves_attempted";
+            case ProfileCounter::MovesBlocked: return "moves_blocked";
+            case ProfileCounter::Attacks: return "attacks";
+            case ProfileCounter::Deaths: return "deaths";
+            case ProfileCounter::EventsLogged: return "events_logged";
+            case ProfileCounter::UnitsWoken: return "units_woken";
+            case ProfileCounter::Count: break;
+        }
+        return "";
+    }
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#ifndef SW_PROFILING
+#define SW_PROFILING 1
+#endif
+
+namespace sw::game
+{
+    // Building with SW_PROFILING=0 removes every profiling hook from the simulation
+    inline constexpr bool PROFILING_COMPILED = SW_PROFILING != 0;
+
+    // Where a tick spends its time
+    enum class ProfilePhase : uint8_t
+    {
+        Paths,   // Updating the flow fields
+        Decide,  // Units choosing their actions
+        Apply,   // Carrying out the actions and logging their events
+        Cleanup, // Removing the dead
+        Count
+    };
+
+    enum class ProfileCounter : uint8_t
+    {
+        RangeQueries,       // Searches for units around a cell
+        CandidatesExamined, // Units those searches visited
+        MovesAttempted,
+        MovesBlocked,       // Marching units with no step to take, or whose step was taken first
+        Attacks,
+        Deaths,
+        EventsLogged,
+        UnitsWoken,         // Sleeping units woken by a change to a cell they had looked at
+        Count
+    };
+
+    // Per-tick timings and counters of a battle.
+    // Switched on by passing one in SimulationOptions; counters may be bumped from the threads
+    // deciding actions, timings are taken on the simulation thread.
+    class Profiler
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t PHASE_COUNT = static_cast<size_t>(ProfilePhase::Count);
+        static constexpr size_t COUNTER_COUNT = static_cast<size_t>(ProfileCounter::Count);
+
+        struct TickRecord
+        {
+            uint64_t tick = 0;
+            uint64_t activeUnits = 0;
+            std::array<uint64_t, PHASE_COUNT> nanoseconds{};
+            std::array<uint64_t, COUNTER_COUNT> counters{};
+        };
+
+    private:
+        std::vector<TickRecord> _ticks;
+        TickRecord _current;
+        std::array<std::atomic<uint64_t>, COUNTER_COUNT> _counters{};
+
+    public:
+        void count(ProfileCounter counter, uint64_t amount = 1)
+        {
+            _counters[static_cast<size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        void addTime(ProfilePhase phase, Clock::duration duration)
+        {
+            _current.nanoseconds[static_cast<size_t>(phase)] += static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+        }
+
+        void beginTick(uint64_t tick);
+        void endTick(uint64_t activeUnits);
+
+        const std::vector<TickRecord>& getTicks() const { return _ticks; }
+        TickRecord getTotals() const;
+
+        // One row per tick
+        void writeCsv(std::ostream& stream) const;
+        // Totals followed by the per-tick records
+        void writeJson(std::ostream& stream) const;
+
+        static const char* toString(ProfilePhase phase);
+        static const char* toString(ProfileCounter counter);
+    };
+
+    // Adds the time until the end of the scope to a phase; does nothing without a profiler
+    class ProfileScope
+    {
+    private:
+        Profiler* _profiler;
+        ProfilePhase _phase;
+        Profiler::Clock::time_point _start;
+
+    public:
+        ProfileScope(Profiler* profiler, ProfilePhase phase)
+            : _profiler(profiler), _phase(phase)
+        {
+            if (_profiler)
+            {
+                _start = Profiler::Clock::now();
+            }
+        }
+
+        ~ProfileScope()
+        {
+            if (_profiler)
+            {
+                _profiler->addTime(_phase, Profiler::Clock::now() - _start);
+            }
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+    };
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+namespace sw::game
+{
+    // Counter-based random numbers (SplitMix64).
+    // A stream is fully determined by its key, so the draws of a unit's turn depend only on
+    // (seed, tick, unit id) and not on how many numbers other units drew before it.
+    class RandomStream
+    {
+    private:
+        static constexpr uint64_t GOLDEN_GAMMA = 0x9e3779b97f4a7c15;
+
+        uint64_t _state;
+
+    public:
+        explicit RandomStream(uint64_t key)
+            : _state(key) {}
+
+        // Stream of one unit's turn
+        RandomStream(uint64_t seed, uint64_t tick, int32_t unitId)
+            : _state(mix(seed ^ mix(tick + GOLDEN_GAMMA * (mix(static_cast<uint32_t>(unitId)) + 1)))) {}
+
+        uint64_t next()
+        {
+            _state += GOLDEN_GAMMA;
+            return mix(_state);
+        }
+
+        // Uniform integer in [0, bound), bound > 0. Rejection keeps it unbiased and, unlike
+        // std::uniform_int_distribution, gives the same result with every standard library.
+        uint64_t nextBelow(uint64_t bound)
+        {
+            const uint64_t threshold = (0 - bound) % bound;
+            uint64_t value = next();
+            while (value < threshold)
+            {
+                value = next();
+            }
+            return value % bound;
+        }
+
+        static uint64_t mix(uint64_t value)
+        {
+            value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+            value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+            return value ^ (value >> 31);
+        }
+    };
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+namespace sw::game
+{
+    class ThreadPool;
+    class Profiler;
+    class SnapshotWriter;
+
+    struct SimulationOptions
+    {
+        // Key of every random draw; the same seed replays the same battle
+        uint64_t seed = 0;
+
+        // Decides unit actions on these threads. Without a pool every tick runs on the calling thread.
+        // Either way the outcome is the same.
+        ThreadPool* threadPool = nullptr;
+
+        // Records per-tick timings and counters when set
+        Profiler* profiler = nullptr;
+
+        // Saves the battle at the start of every tick it asks for when set
+        SnapshotWriter* snapshots = nullptr;
+    };
+}
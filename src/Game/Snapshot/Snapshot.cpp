@@ -0,0 +1,224 @@
+#include "Snapshot.hpp"
+#include "SnapshotWriter.hpp"
+#include "../GameState.hpp"
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace sw::game
+{
+    namespace
+    {
+        // Records are stored as they lie in memory
+        static_assert(std::endian::native == std::endian::little, "Snapshots are little-endian");
+
+        constexpr char MAGIC[8] = {'S', 'W', 'S', 'N', 'A', 'P', '\0', '\0'};
+        constexpr uint32_t VERSION = 2; // Version 1 also saved the windows of the march routes' fields
+
+        struct Header
+        {
+            char magic[8];
+            uint32_t version;
+            int32_t width;
+            int32_t height;
+            uint32_t reserved;
+            uint64_t seed;
+            uint64_t tick;
+            uint64_t ticksWithoutChanges;
+            uint64_t previousActiveCount;
+            uint64_t unitCount;
+        };
+
+        // One unit that is still on the map, in creation order
+        struct UnitRecord
+        {
+            int32_t id;
+            uint8_t type;
+            uint8_t hasTarget;
+            uint16_t reserved;
+            int32_t x;
+            int32_t y;
+            int32_t targetX;
+            int32_t targetY;
+            int32_t hp;
+            int32_t maxHp;
+            int32_t stats[3]; // The type's stats in visit() order, e.g. Hunter: agility, strength, range
+        };
+
+        static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) == 64);
+        static_assert(std::is_trivially_copyable_v<UnitRecord> && sizeof(UnitRecord) == 44);
+
+        // Number of stats a unit type has, which must fit UnitRecord::stats
+        template <typename TStats>
+        constexpr size_t statCount()
+        {
+            TStats stats;
+            size_t count = 0;
+            stats.visit([&count](int32_t) { ++count; });
+            return count;
+        }
+
+        template <size_t... Indices>
+        constexpr bool statsFitRecord(std::index_sequence<Indices...>)
+        {
+            return ((statCount<std::tuple_element_t<Indices, AllUnitStats>>() <= sizeof(UnitRecord::stats) / sizeof(int32_t)) && ...);
+        }
+
+        static_assert(statsFitRecord(std::make_index_sequence<UNIT_TYPE_COUNT>{}), "A unit type has more stats than a snapshot record holds");
+
+        template <typename TRecord>
+        void append(std::vector<char>& output, const TRecord& record)
+        {
+            const char* bytes = reinterpret_cast<const char*>(&record);
+            output.insert(output.end(), bytes, bytes + sizeof(TRecord));
+        }
+
+        template <typename TRecord>
+        TRecord readRecord(const char* data)
+        {
+            TRecord record;
+            std::memcpy(&record, data, sizeof(TRecord));
+            return record;
+        }
+    }
+
+    void writeSnapshot(const GameState& state, std::vector<char>& output)
+    {
+        const UnitStorage& units = state._units;
+
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.width = state._map.getWidth();
+        header.height = state._map.getHeight();
+        header.seed = state._options.seed;
+        header.tick = state._currentTick;
+        header.ticksWithoutChanges = state._ticksWithoutChanges;
+        header.previousActiveCount = state._previousActiveCount;
+        header.unitCount = units.size();
+
+        output.reserve(output.size() + sizeof(Header) + header.unitCount * sizeof(UnitRecord));
+        append(output, header);
+
+        for (UnitSlot slot = 0; slot < units.getSlotCount(); ++slot)
+        {
+            if (units.isRemoved(slot))
+            {
+                continue;
+            }
+
+            UnitRecord record{};
+            record.id = units.getId(slot);
+            record.type = static_cast<uint8_t>(units.getType(slot));
+            record.x = units.getPosition(slot).x;
+            record.y = units.getPosition(slot).y;
+            if (const auto& target = units.getTarget(slot))
+            {
+                record.hasTarget = 1;
+                record.targetX = target->x;
+                record.targetY = target->y;
+            }
+            record.hp = units.getHp(slot);
+            record.maxHp = units.getMaxHp(slot);
+            visitUnitType(units.getType(slot), [&units, &record, slot]<typename TUnit>(std::type_identity<TUnit>)
+            {
+                auto stats = units.getStats<typename TUnit::Stats>(slot);
+                size_t field = 0;
+                stats.visit([&record, &field](int32_t value) { record.stats[field++] = value; });
+            });
+            append(output, record);
+        }
+    }
+
+    std::unique_ptr<GameState> readSnapshot(std::string_view data, const SimulationOptions& options, sw::EventLog& eventLog)
+    {
+        if (data.size() < sizeof(Header))
+        {
+            throw std::runtime_error("Error: Not a snapshot");
+        }
+        const Header header = readRecord<Header>(data.data());
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+        {
+            throw std::runtime_error("Error: Not a snapshot");
+        }
+        if (header.version != VERSION)
+        {
+            throw std::runtime_error("Error: Unsupported snapshot version " + std::to_string(header.version));
+        }
+        if (header.unitCount > data.size() / sizeof(UnitRecord) || data.size() != sizeof(Header) + header.unitCount * sizeof(UnitRecord))
+        {
+            throw std::runtime_error("Error: Truncated or corrupt snapshot");
+        }
+
+        SimulationOptions restoredOptions = options;
+        restoredOptions.seed = header.seed;
+        std::unique_ptr<GameState> state(new GameState(GameState::RestoreTag{}, header.width, header.height, restoredOptions, eventLog));
+        state->_currentTick = header.tick;
+        state->_ticksWithoutChanges = header.ticksWithoutChanges;
+        state->_previousActiveCount = header.previousActiveCount;
+
+        UnitStorage& units = state->_units;
+        const char* next = data.data() + sizeof(Header);
+        for (uint64_t i = 0; i < header.unitCount; ++i, next += sizeof(UnitRecord))
+        {
+            const UnitRecord record = readRecord<UnitRecord>(next);
+            const Position position(record.x, record.y);
+            if (units.contains(record.id) || state->_map.isOccupied(position))
+            {
+                throw std::runtime_error("Error: Corrupt snapshot: unit " + std::to_string(record.id) + " cannot be placed");
+            }
+
+            if (record.type >= UNIT_TYPE_COUNT)
+            {
+                throw std::runtime_error("Error: Corrupt snapshot: unknown unit type " + std::to_string(record.type));
+            }
+            const UnitSlot slot = visitUnitType(static_cast<UnitType>(record.type), [&units, &record, &position]<typename TUnit>(std::type_identity<TUnit>)
+            {
+                typename TUnit::Stats stats;
+                size_t field = 0;
+                stats.visit([&record, &field](int32_t& value) { value = record.stats[field++]; });
+                return units.add(record.id, position, record.hp, stats);
+            });
+            units.setMaxHp(slot, record.maxHp);
+            state->_map.placeUnit(position, slot);
+            state->_turnQueue.push(slot);
+            if (record.hasTarget)
+            {
+                const Position target(record.targetX, record.targetY);
+                units.setTarget(slot, target);
+                state->_pathPlanner.onTargetChanged(slot, position, std::nullopt, target);
+            }
+        }
+
+        return state;
+    }
+
+    SnapshotWriter::SnapshotWriter(uint64_t interval, std::string pathPrefix)
+        : _interval(interval), _pathPrefix(std::move(pathPrefix)) {}
+
+    void SnapshotWriter::onTickStart(const GameState& state)
+    {
+        if (_interval == 0 || state.getCurrentTick() % _interval != 0)
+        {
+            return;
+        }
+
+        std::vector<char> data;
+        writeSnapshot(state, data);
+
+        const std::string path = getPath(state.getCurrentTick());
+        std::ofstream file(path, std::ios::binary);
+        if (!file.write(data.data(), static_cast<std::streamsize>(data.size())))
+        {
+            throw std::runtime_error("Error: Cannot write snapshot - " + path);
+        }
+    }
+
+    std::string SnapshotWriter::getPath(uint64_t tick) const
+    {
+        return _pathPrefix + std::to_string(tick) + ".snap";
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "../SimulationOptions.hpp"
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace sw
+{
+    class EventLog;
+}
+
+namespace sw::game
+{
+    class GameState;
+
+    // Versioned binary image of a battle between two ticks: the map size, the seed, the tick,
+    // the hang detector, and every unit with its stats and march target. The march routes' fields
+    // follow from those, so they are rebuilt rather than saved. Units are fixed-size records, so
+    // a memory-mapped snapshot is restored in one pass without parsing. Scripted commands still
+    // to come are not included.
+    void writeSnapshot(const GameState& state, std::vector<char>& output);
+
+    // Rebuilds a saved battle that continues with the given options, except for the saved seed, and event log.
+    // Restoring logs no events. Throws std::runtime_error for data that is not a valid snapshot.
+    std::unique_ptr<GameState> readSnapshot(std::string_view data, const SimulationOptions& options, sw::EventLog& eventLog);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace sw::game
+{
+    class GameState;
+
+    // Saves the battle every few ticks to <prefix><tick>.snap (see Snapshot.hpp)
+    class SnapshotWriter
+    {
+    private:
+        uint64_t _interval;
+        std::string _pathPrefix;
+
+    public:
+        SnapshotWriter(uint64_t interval, std::string pathPrefix);
+
+        // Called at the start of every tick after the first
+        void onTickStart(const GameState& state);
+
+        std::string getPath(uint64_t tick) const;
+    };
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "Map.hpp"
+#include "Position.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace sw::game
+{
+    // Answers "which units are around this cell" queries straight from the map's
+    // occupancy grid. The query disc (or ring) is walked row by row, so the cost
+    // depends on the searched area and not on the number of units in the game.
+    class SpatialIndex
+    {
+    private:
+        const Map& _map;
+
+    public:
+        explicit SpatialIndex(const Map& map) : _map(map) {}
+
+        // Largest squared cell distance that still satisfies distanceTo() <= range
+        static int64_t toDistanceSq(double range)
+        {
+            if (range < 0.0)
+            {
+                return -1;
+            }
+            return static_cast<int64_t>(std::floor(range * range));
+        }
+
+        // Smallest squared cell distance that still satisfies distanceTo() >= range
+        static int64_t toMinDistanceSq(double range)
+        {
+            if (range <= 0.0)
+            {
+                return 0;
+            }
+            return static_cast<int64_t>(std::ceil(range * range));
+        }
+
+        // Visits every occupied cell whose squared distance from the center lies
+        // within [minDistSq, maxDistSq]. The callback receives (slot, position).
+        template <typename TCallback>
+        void forEachInAnnulus(const Position& center, int64_t minDistSq, int64_t maxDistSq, TCallback&& callback) const
+        {
+            if (maxDistSq < 0 || minDistSq > maxDistSq)
+            {
+                return;
+            }
+
+            const int64_t radius = isqrt(maxDistSq);
+            const int32_t minY = static_cast<int32_t>(std::max<int64_t>(0, center.y - radius));
+            const int32_t maxY = static_cast<int32_t>(std::min<int64_t>(_map.getHeight() - 1, center.y + radius));
+
+            for (int32_t y = minY; y <= maxY; ++y)
+            {
+                const int64_t dy = y - center.y;
+                const int64_t dySq = dy * dy;
+                const int64_t outer = isqrt(maxDistSq - dySq);
+
+                // Cells closer than the inner radius split the row into two spans
+                int64_t inner = -1;
+                if (minDistSq > dySq)
+                {
+                    inner = ceilSqrt(minDistSq - dySq);
+                }
+
+                if (inner <= 0)
+                {
+                    scanRow(y, center.x - outer, center.x + outer, callback);
+                }
+                else if (inner <= outer)
+                {
+                    scanRow(y, center.x - outer, center.x - inner, callback);
+                    scanRow(y, center.x + inner, center.x + outer, callback);
+                }
+            }
+        }
+
+        // Visits every occupied cell within the given squared distance of the center
+        template <typename TCallback>
+        void forEachInRange(const Position& center, int64_t maxDistSq, TCallback&& callback) const
+        {
+            forEachInAnnulus(center, 0, maxDistSq, std::forward<TCallback>(callback));
+        }
+
+        // Visits every occupied cell within the given Chebyshev distance of the center
+        template <typename TCallback>
+        void forEachInSquare(const Position& center, int32_t radius, TCallback&& callback) const
+        {
+            if (radius < 0)
+            {
+                return;
+            }
+
+            const int32_t minY = static_cast<int32_t>(std::max<int64_t>(0, int64_t{center.y} - radius));
+            const int32_t maxY = static_cast<int32_t>(std::min<int64_t>(_map.getHeight() - 1, int64_t{center.y} + radius));
+            for (int32_t y = minY; y <= maxY; ++y)
+            {
+                scanRow(y, int64_t{center.x} - radius, int64_t{center.x} + radius, callback);
+            }
+        }
+
+    private:
+        template <typename TCallback>
+        void scanRow(int32_t y, int64_t fromX, int64_t toX, TCallback& callback) const
+        {
+            const int32_t x0 = static_cast<int32_t>(std::max<int64_t>(0, fromX));
+            const int32_t x1 = static_cast<int32_t>(std::min<int64_t>(_map.getWidth() - 1, toX));
+            if (x0 <= x1)
+            {
+                _map.forEachUnitInRow(y, x0, x1, callback);
+            }
+        }
+
+        static int64_t isqrt(int64_t value)
+        {
+            int64_t root = static_cast<int64_t>(std::sqrt(static_cast<double>(value)));
+            while (root * root > value)
+            {
+                --root;
+            }
+            while ((root + 1) * (root + 1) <= value)
+            {
+                ++root;
+            }
+            return root;
+        }
+
+        static int64_t ceilSqrt(int64_t value)
+        {
+            int64_t root = isqrt(value);
+            return root * root == value ? root : root + 1;
+        }
+    };
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Units/UnitSlot.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace sw::game
+{
+    // Order in which units take their turns: the order they were created in, which is slot order.
+    // A unit that cannot act until something around it changes is put to sleep and not visited
+    // again until GameState wakes it. The awake units are a bitset over slots, so a tick costs
+    // one word per 64 slots plus its awake units, and a unit woken during a tick still takes its
+    // turn in that tick when its slot comes after the one being played.
+    class TurnQueue
+    {
+    private:
+        static constexpr int32_t AWAKE = -1;
+
+        std::vector<uint64_t> _awake;
+        std::vector<int32_t> _sleepReach; // Per slot: cells around a sleeper that would wake it, or AWAKE
+        size_t _awakeCount = 0;
+        size_t _sleepingCount = 0;
+        int32_t _maxSleepReach = 0; // Of the units asleep since the last time none were
+
+    public:
+        static constexpr UnitSlot END = ~UnitSlot{0};
+
+        // Queues a newly created unit, awake
+        void push(UnitSlot slot)
+        {
+            if (slot >= _sleepReach.size())
+            {
+                _sleepReach.resize(slot + 1, AWAKE);
+                _awake.resize((_sleepReach.size() + 63) / 64, 0);
+            }
+            _sleepReach[slot] = AWAKE;
+            setAwake(slot);
+        }
+
+        // Drops a unit removed from storage, asleep or not
+        void remove(UnitSlot slot)
+        {
+            if (isAsleep(slot))
+            {
+                --_sleepingCount;
+                _sleepReach[slot] = AWAKE;
+            }
+            else if (isAwake(slot))
+            {
+                clearAwake(slot);
+            }
+        }
+
+        // The unit skips its turns until woken. Reach is the Chebyshev distance of the cells its
+        // last decision read; a change to any of them may change its mind.
+        void sleep(UnitSlot slot, int32_t reach)
+        {
+            clearAwake(slot);
+            _sleepReach[slot] = std::max(reach, 0);
+            _maxSleepReach = _sleepingCount == 0 ? _sleepReach[slot] : std::max(_maxSleepReach, _sleepReach[slot]);
+            ++_sleepingCount;
+        }
+
+        // Returns whether the unit was asleep
+        bool wake(UnitSlot slot)
+        {
+            if (!isAsleep(slot))
+            {
+                return false;
+            }
+
+            _sleepReach[slot] = AWAKE;
+            --_sleepingCount;
+            setAwake(slot);
+            return true;
+        }
+
+        bool isAwake(UnitSlot slot) const { return (_awake[slot / 64] >> (slot % 64)) & 1; }
+        bool isAsleep(UnitSlot slot) const { return slot < _sleepReach.size() && _sleepReach[slot] != AWAKE; }
+        int32_t getSleepReach(UnitSlot slot) const { return _sleepReach[slot]; }
+
+        size_t getAwakeCount() const { return _awakeCount; }
+        // No sleeper reaches further than this
+        int32_t getMaxSleepReach() const { return _maxSleepReach; }
+
+        // First awake slot from the given one on, or END. Reads the bitset as it is now, so a walk
+        // over the queue also meets the units woken further along while it is under way.
+        UnitSlot nextAwake(UnitSlot from) const
+        {
+            size_t word = from / 64;
+            if (word >= _awake.size())
+            {
+                return END;
+            }
+
+            uint64_t bits = _awake[word] & (~uint64_t{0} << (from % 64));
+            while (bits == 0)
+            {
+                if (++word == _awake.size())
+                {
+                    return END;
+                }
+                bits = _awake[word];
+            }
+            return static_cast<UnitSlot>(word * 64 + std::countr_zero(bits));
+        }
+
+    private:
+        void setAwake(UnitSlot slot)
+        {
+            _awake[slot / 64] |= uint64_t{1} << (slot % 64);
+            ++_awakeCount;
+        }
+
+        void clearAwake(UnitSlot slot)
+        {
+            _awake[slot / 64] &= ~(uint64_t{1} << (slot % 64));
+            --_awakeCount;
+        }
+    };
+}
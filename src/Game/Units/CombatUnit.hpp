@@ -1,35 +1,28 @@
 #pragma once
 
 #include "Unit.hpp"
+#include <algorithm>
 
 namespace sw::game
 {
     class CombatUnit : public Unit
     {
-    protected:
-        int32_t _hp;
-        int32_t _maxHp;
-
     public:
-        CombatUnit(int32_t id, const Position& position, const std::string& type, int32_t hp)
-            : Unit(id, position, type), _hp(hp), _maxHp(hp) {}
+        CombatUnit(UnitStorage& storage, UnitSlot slot)
+            : Unit(storage, slot) {}
 
-        int32_t getHp() const { return _hp; }
-        int32_t getMaxHp() const { return _maxHp; }
+        int32_t getHp() const { return _storage->getHp(_slot); }
+        int32_t getMaxHp() const { return _storage->getMaxHp(_slot); }
         
+        // Reaching zero HP puts the unit on the storage's dead list for end-of-tick cleanup
         void takeDamage(int32_t amount)
         {
-            _hp = std::max(0, _hp - amount);
+            _storage->setHp(_slot, std::max(0, getHp() - amount));
         }
         
         void heal(int32_t amount)
         {
-            _hp = std::min(_maxHp, _hp + amount);
-        }
-        
-        bool isActive() const override
-        {
-            return _hp > 0;
+            _storage->setHp(_slot, std::min(getMaxHp(), getHp() + amount));
         }
     };
-} 
\ No newline at end of file
+}
@@ -1,139 +1,59 @@
 #include "Hunter.hpp"
 #include "../GameState.hpp"
-#include <IO/Events/UnitAttacked.hpp>
 #include <algorithm>
-#include <vector>
 
 namespace sw::game
 {
     bool Hunter::canShoot(const GameState& state) const
     {
-        // Hunter can't shoot if there are adjacent units
-        auto adjacentUnits = state.getAdjacentUnits(_position);
-        return adjacentUnits.empty();
+        // Hunter can't shoot if there are other units in adjacent cells
+        return !state.hasAdjacentUnits(getPosition());
     }
 
-    bool Hunter::tryRangedAttack(GameState& state)
+    std::optional<UnitAction> Hunter::decideRangedAttack(const GameState& state, RandomStream& random) const
     {
         if (!canShoot(state))
         {
-            return false;
+            return std::nullopt;
         }
 
-        // Find all units in range (from 2 to _range)
-        std::vector<UnitPtr> targetsInRange;
-        
-        for (double r = 2.0; r <= _range; r += 0.5)
-        {
-            auto unitsAtRange = state.getUnitsInRange(_position, r);
-            for (const auto& unit : unitsAtRange)
-            {
-                // Only include units that are not too close and not already in our list
-                double distance = unit->getPosition().distanceTo(_position);
-                if (distance >= 2.0 && 
-                    std::find_if(targetsInRange.begin(), targetsInRange.end(),
-                        [&unit](const UnitPtr& existing) { return existing->getId() == unit->getId(); }) 
-                    == targetsInRange.end())
-                {
-                    targetsInRange.push_back(unit);
-                }
-            }
-        }
-
-        if (targetsInRange.empty())
-        {
-            return false;
-        }
-
-        // Choose a random target
-        UnitPtr target = state.getRandomUnit(targetsInRange);
+        // Choose a random target among the units from 2 to range cells away
+        auto target = state.getRandomUnitInAnnulus(getPosition(), 2.0, getRange(), random);
         if (!target)
         {
-            return false;
-        }
-
-        // Attack the target
-        auto combatTarget = std::dynamic_pointer_cast<CombatUnit>(target);
-        if (!combatTarget)
-        {
-            return false;
+            return std::nullopt;
         }
 
-        combatTarget->takeDamage(_agility);
-        
-        // Log the attack
-        state.logEvent(io::UnitAttacked{
-            static_cast<uint32_t>(_id),
-            static_cast<uint32_t>(target->getId()),
-            static_cast<uint32_t>(_agility),
-            static_cast<uint32_t>(combatTarget->getHp())
-        });
-        
-        return true;
+        return UnitAction::attack(*target, getAgility());
     }
 
-    bool Hunter::tryMeleeAttack(GameState& state)
+    std::optional<UnitAction> Hunter::decideMeleeAttack(const GameState& state, RandomStream& random) const
     {
-        // Try to attack an adjacent unit
-        auto adjacentUnits = state.getAdjacentUnits(_position);
-        
-        // Remove self from adjacent units if somehow included
-        adjacentUnits.erase(
-            std::remove_if(adjacentUnits.begin(), adjacentUnits.end(),
-                [this](const UnitPtr& unit) { return unit->getId() == _id; }),
-            adjacentUnits.end()
-        );
-        
-        if (adjacentUnits.empty())
-        {
-            return false;
-        }
-
-        // Choose a random unit to attack
-        UnitPtr target = state.getRandomUnit(adjacentUnits);
+        // Try to attack a random adjacent unit
+        auto target = state.getRandomAdjacentUnit(getPosition(), random);
         if (!target)
         {
-            return false;
+            return std::nullopt;
         }
 
-        // Attack the target
-        auto combatTarget = std::dynamic_pointer_cast<CombatUnit>(target);
-        if (!combatTarget)
-        {
-            return false;
-        }
-
-        combatTarget->takeDamage(_strength);
-        
-        // Log the attack
-        state.logEvent(io::UnitAttacked{
-            static_cast<uint32_t>(_id),
-            static_cast<uint32_t>(target->getId()),
-            static_cast<uint32_t>(_strength),
-            static_cast<uint32_t>(combatTarget->getHp())
-        });
-        
-        return true;
+        return UnitAction::attack(*target, getStrength());
     }
 
-    void Hunter::performAction(GameState& state)
+    UnitAction Hunter::decideAction(const GameState& state, RandomStream& random) const
     {
-        // Try ranged attack first
-        if (tryRangedAttack(state))
+        // Try ranged attack first, then melee, then move towards target
+        std::optional<UnitAction> action = decideRangedAttack(state, random);
+        if (!action)
         {
-            return; // Action completed
+            action = decideMeleeAttack(state, random);
         }
-
-        // If ranged attack failed, try melee attack
-        if (tryMeleeAttack(state))
+        if (!action)
         {
-            return; // Action completed
+            action = decideMove(state);
         }
 
-        // If no attack was performed, try to move towards target
-        if (_targetPosition)
-        {
-            moveTowardsTarget(state);
-        }
+        // Looking for a ranged target reads every cell within range
+        action->reach = canShoot(state) ? std::max(1, getRange()) : 1;
+        return *action;
     }
-} 
\ No newline at end of file
+}
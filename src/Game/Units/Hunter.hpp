@@ -6,24 +6,25 @@ namespace sw::game
 {
     class Hunter : public CombatUnit
     {
-    private:
-        int32_t _agility;
-        int32_t _strength;
-        int32_t _range;
-
     public:
-        Hunter(int32_t id, const Position& position, int32_t hp, int32_t agility, int32_t strength, int32_t range)
-            : CombatUnit(id, position, "Hunter", hp), _agility(agility), _strength(strength), _range(range) {}
+        static constexpr UnitType Type = UnitType::Hunter;
+        using Stats = HunterStats;
+
+        Hunter(UnitStorage& storage, UnitSlot slot)
+            : CombatUnit(storage, slot) {}
+
+        int32_t getAgility() const { return getStats().agility; }
+        int32_t getStrength() const { return getStats().strength; }
+        int32_t getRange() const { return getStats().range; }
 
-        int32_t getAgility() const { return _agility; }
-        int32_t getStrength() const { return _strength; }
-        int32_t getRange() const { return _range; }
+        UnitAction decideAction(const GameState& state, RandomStream& random) const;
 
-        void performAction(GameState& state) override;
+        // The shot the hunter would take this turn, if it is free to shoot and has a target in range
+        std::optional<UnitAction> decideRangedAttack(const GameState& state, RandomStream& random) const;
         
     private:
+        const Stats& getStats() const { return _storage->getStats<Stats>(_slot); }
         bool canShoot(const GameState& state) const;
-        bool tryRangedAttack(GameState& state);
-        bool tryMeleeAttack(GameState& state);
+        std::optional<UnitAction> decideMeleeAttack(const GameState& state, RandomStream& random) const;
     };
-} 
\ No newline at end of file
+}
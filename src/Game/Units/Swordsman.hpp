@@ -6,15 +6,18 @@ namespace sw::game
 {
     class Swordsman : public CombatUnit
     {
-    private:
-        int32_t _strength;
-
     public:
-        Swordsman(int32_t id, const Position& position, int32_t hp, int32_t strength)
-            : CombatUnit(id, position, "Swordsman", hp), _strength(strength) {}
+        static constexpr UnitType Type = UnitType::Swordsman;
+        using Stats = SwordsmanStats;
+
+        Swordsman(UnitStorage& storage, UnitSlot slot)
+            : CombatUnit(storage, slot) {}
 
-        int32_t getStrength() const { return _strength; }
+        int32_t getStrength() const { return getStats().strength; }
 
-        void performAction(GameState& state) override;
+        UnitAction decideAction(const GameState& state, RandomStream& random) const;
+
+    private:
+        const Stats& getStats() const { return _storage->getStats<Stats>(_slot); }
     };
-} 
\ No newline at end of file
+}
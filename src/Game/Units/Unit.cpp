@@ -1,80 +1,109 @@
 #include "Unit.hpp"
+#include "CombatUnit.hpp"
 #include "../GameState.hpp"
+#include <IO/Events/UnitAttacked.hpp>
 #include <IO/Events/UnitMoved.hpp>
 #include <IO/Events/MarchEnded.hpp>
-#include <algorithm>
-#include <vector>
 
 namespace sw::game
 {
-    bool Unit::moveTowardsTarget(GameState& state)
+    void Unit::apply(GameState& state, const UnitAction& action)
     {
-        if (!_targetPosition)
+        switch (action.kind)
         {
-            return false;
+            case UnitAction::Kind::None:
+                break;
+            case UnitAction::Kind::Attack:
+                attack(state, action.target, action.damage);
+                break;
+            case UnitAction::Kind::Move:
+                move(state, action.destination);
+                break;
+            case UnitAction::Kind::EndMarch:
+                state.setMarchTarget(_slot, std::nullopt);
+                break;
         }
+    }
 
-        // If already at target position, we're done
-        if (_position == *_targetPosition)
+    UnitAction Unit::decideMove(const GameState& state) const
+    {
+        const auto targetPosition = getTargetPosition();
+        if (!targetPosition)
         {
-            _targetPosition = std::nullopt;
-            return false;
+            return UnitAction::none();
         }
 
-        // Get all adjacent positions
-        auto adjacentPositions = state.getMap().getAdjacentPositions(_position);
-        
-        // Filter out occupied positions
-        adjacentPositions.erase(
-            std::remove_if(adjacentPositions.begin(), adjacentPositions.end(),
-                [&state](const Position& pos) { return state.getMap().isOccupied(pos); }),
-            adjacentPositions.end()
-        );
+        const Position target = *targetPosition;
+        const Position position = getPosition();
 
-        if (adjacentPositions.empty())
+        // If already at target position, we're done
+        if (position == target)
         {
-            return false; // No valid moves
+            return UnitAction::endMarch();
         }
 
-        // Find the position closest to the target
-        Position bestMove = adjacentPositions[0];
-        double bestDistance = bestMove.distanceTo(*_targetPosition);
+        // Free neighbouring cells come from one bitset probe
+        const uint8_t freeCells = state.getMap().getFreeNeighbours(position);
+        if (freeCells == 0)
+        {
+            state.count(ProfileCounter::MovesBlocked);
+            return UnitAction::none(); // No valid moves
+        }
 
-        for (size_t i = 1; i < adjacentPositions.size(); ++i)
+        // The step comes from the flow field shared by all units marching to this target
+        auto nextPosition = state.getPathPlanner().chooseStep(position, target, freeCells);
+        if (!nextPosition)
         {
-            double distance = adjacentPositions[i].distanceTo(*_targetPosition);
-            if (distance < bestDistance)
-            {
-                bestMove = adjacentPositions[i];
-                bestDistance = distance;
-            }
+            state.count(ProfileCounter::MovesBlocked);
+            return UnitAction::none();
         }
 
-        // Move to the best position
-        Position oldPosition = _position;
-        _position = bestMove;
-        
-        // Update the map
-        state.getMap().moveUnit(oldPosition, bestMove);
+        return UnitAction::move(*nextPosition);
+    }
+
+    void Unit::move(GameState& state, const Position& destination)
+    {
+        state.moveUnit(_slot, destination);
         
         // Log the movement event
-        state.logEvent(io::UnitMoved{
-            static_cast<uint32_t>(_id), 
-            static_cast<uint32_t>(bestMove.x), 
-            static_cast<uint32_t>(bestMove.y)
+        state.logEvent([this, &destination]
+        {
+            return io::UnitMoved{
+                static_cast<uint32_t>(getId()), 
+                static_cast<uint32_t>(destination.x), 
+                static_cast<uint32_t>(destination.y)
+            };
         });
 
         // Check if we've reached the target
-        if (_position == *_targetPosition)
+        if (destination == getTargetPosition())
         {
-            state.logEvent(io::MarchEnded{
-                static_cast<uint32_t>(_id), 
-                static_cast<uint32_t>(_position.x), 
-                static_cast<uint32_t>(_position.y)
+            state.logEvent([this, &destination]
+            {
+                return io::MarchEnded{
+                    static_cast<uint32_t>(getId()), 
+                    static_cast<uint32_t>(destination.x), 
+                    static_cast<uint32_t>(destination.y)
+                };
             });
-            _targetPosition = std::nullopt;
+            state.setMarchTarget(_slot, std::nullopt);
         }
+    }
 
-        return true;
+    void Unit::attack(GameState& state, UnitSlot target, int32_t damage)
+    {
+        CombatUnit combatTarget(*_storage, target);
+        combatTarget.takeDamage(damage);
+        state.count(ProfileCounter::Attacks);
+
+        state.logEvent([this, &combatTarget, damage]
+        {
+            return io::UnitAttacked{
+                static_cast<uint32_t>(getId()),
+                static_cast<uint32_t>(combatTarget.getId()),
+                static_cast<uint32_t>(damage),
+                static_cast<uint32_t>(combatTarget.getHp())
+            };
+        });
     }
-} 
\ No newline at end of file
+}
@@ -1,47 +1,49 @@
 #pragma once
 
+#include "UnitAction.hpp"
+#include "UnitStorage.hpp"
 #include "../Position.hpp"
-#include <string>
-#include <memory>
 #include <optional>
+#include <string_view>
 
 namespace sw::game
 {
     class GameState;
+    class RandomStream;
 
+    // Lightweight view of one unit's components in UnitStorage.
+    // Views are cheap to copy and only valid while the storage they point to is alive.
     class Unit
     {
     protected:
-        int32_t _id;
-        Position _position;
-        std::optional<Position> _targetPosition;
-        std::string _type;
+        UnitStorage* _storage;
+        UnitSlot _slot;
 
     public:
-        Unit(int32_t id, const Position& position, const std::string& type)
-            : _id(id), _position(position), _targetPosition(std::nullopt), _type(type) {}
-        
-        virtual ~Unit() = default;
-
-        int32_t getId() const { return _id; }
-        const Position& getPosition() const { return _position; }
-        const std::string& getType() const { return _type; }
-        
-        void setPosition(const Position& position) { _position = position; }
-        
-        std::optional<Position> getTargetPosition() const { return _targetPosition; }
-        void setTargetPosition(const Position& target) { _targetPosition = target; }
-        void clearTargetPosition() { _targetPosition = std::nullopt; }
-
-        // Each unit type will implement its own action logic
-        virtual void performAction(GameState& state) = 0;
+        Unit(UnitStorage& storage, UnitSlot slot)
+            : _storage(&storage), _slot(slot) {}
+
+        UnitSlot getSlot() const { return _slot; }
+        int32_t getId() const { return _storage->getId(_slot); }
+        const Position& getPosition() const { return _storage->getPosition(_slot); }
+        UnitType getUnitType() const { return _storage->getType(_slot); }
+        std::string_view getType() const { return toString(getUnitType()); }
+
+        // Marches are started and moves are made through GameState, which keeps the map and pathing in sync
+        std::optional<Position> getTargetPosition() const { return _storage->getTarget(_slot); }
 
         // Check if unit is alive and can perform actions
-        virtual bool isActive() const = 0;
+        bool isActive() const { return _storage->isActive(_slot); }
 
-        // Move towards target if one exists
-        virtual bool moveTowardsTarget(GameState& state);
-    };
+        // Carries out a decided action and logs its events
+        void apply(GameState& state, const UnitAction& action);
 
-    using UnitPtr = std::shared_ptr<Unit>;
-} 
\ No newline at end of file
+    protected:
+        // Step towards the march target if there is one
+        UnitAction decideMove(const GameState& state) const;
+
+    private:
+        void attack(GameState& state, UnitSlot target, int32_t damage);
+        void move(GameState& state, const Position& destination);
+    };
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "UnitSlot.hpp"
+#include "../Position.hpp"
+#include <cstdint>
+
+namespace sw::game
+{
+    // What a unit decided to do with its turn.
+    // Deciding only reads the game state and applying does all the writes, so the decisions of
+    // a tick can be made up front and applied afterwards in creation order.
+    struct UnitAction
+    {
+        enum class Kind : uint8_t
+        {
+            None,
+            Attack,   // Deal damage to the unit in target
+            Move,     // Step to destination, ending the march there if it is the target
+            EndMarch  // Already standing on the march target
+        };
+
+        Kind kind = Kind::None;
+        UnitSlot target = 0;
+        int32_t damage = 0;
+        Position destination;
+
+        // The decision read only map cells within this Chebyshev distance of the unit
+        int32_t reach = 1;
+
+        static UnitAction none() { return UnitAction{}; }
+
+        static UnitAction attack(UnitSlot target, int32_t damage)
+        {
+            UnitAction action;
+            action.kind = Kind::Attack;
+            action.target = target;
+            action.damage = damage;
+            return action;
+        }
+
+        static UnitAction move(const Position& destination)
+        {
+            UnitAction action;
+            action.kind = Kind::Move;
+            action.destination = destination;
+            return action;
+        }
+
+        static UnitAction endMarch()
+        {
+            UnitAction action;
+            action.kind = Kind::EndMarch;
+            return action;
+        }
+    };
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstdint>
+
+namespace sw::game
+{
+    // Index of a unit's components in UnitStorage. Slots are handed out in creation order.
+    using UnitSlot = uint32_t;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace sw::game
+{
+    enum class UnitType : uint8_t
+    {
+        Swordsman,
+        Hunter
+    };
+
+    // Per-type data kept in UnitStorage: the type's name for events and its stats.
+    // visit() passes every stat to the visitor, in the order snapshots store them.
+    struct SwordsmanStats
+    {
+        static constexpr UnitType Type = UnitType::Swordsman;
+        static constexpr std::string_view Name = "Swordsman";
+
+        int32_t strength{};
+
+        template <typename TVisitor>
+        constexpr void visit(TVisitor&& visitor)
+        {
+            visitor(strength);
+        }
+    };
+
+    struct HunterStats
+    {
+        static constexpr UnitType Type = UnitType::Hunter;
+        static constexpr std::string_view Name = "Hunter";
+
+        int32_t agility{};
+        int32_t strength{};
+        int32_t range{};
+
+        template <typename TVisitor>
+        constexpr void visit(TVisitor&& visitor)
+        {
+            visitor(agility);
+            visitor(strength);
+            visitor(range);
+        }
+    };
+
+    // Stats of every unit type, in UnitType order. UnitStorage keeps a pool for each entry;
+    // the unit classes are listed in the same order in UnitTypes.hpp.
+    using AllUnitStats = std::tuple<SwordsmanStats, HunterStats>;
+
+    constexpr size_t UNIT_TYPE_COUNT = std::tuple_size_v<AllUnitStats>;
+
+    template <size_t... Indices>
+    constexpr bool statsMatchTypes(std::index_sequence<Indices...>)
+    {
+        return ((std::tuple_element_t<Indices, AllUnitStats>::Type == static_cast<UnitType>(Indices)) && ...);
+    }
+
+    static_assert(statsMatchTypes(std::make_index_sequence<UNIT_TYPE_COUNT>{}), "AllUnitStats must follow UnitType order");
+
+    inline std::string_view toString(UnitType type)
+    {
+        static constexpr auto names = []<size_t... Indices>(std::index_sequence<Indices...>)
+        {
+            return std::array<std::string_view, UNIT_TYPE_COUNT>{std::tuple_element_t<Indices, AllUnitStats>::Name...};
+        }(std::make_index_sequence<UNIT_TYPE_COUNT>{});
+        return names[static_cast<size_t>(type)];
+    }
+}
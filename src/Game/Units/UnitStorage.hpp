@@ -0,0 +1,152 @@
+#pragma once
+
+#include "UnitSlot.hpp"
+#include "UnitStats.hpp"
+#include "../Position.hpp"
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace sw::game
+{
+    // Data-oriented storage for all units of a game.
+    // Every component lives in its own contiguous array indexed by UnitSlot, so systems that
+    // touch one component (positions for range queries, HP for attacks) stream through memory
+    // instead of chasing per-unit heap objects. Type-specific stats are kept in per-type pools.
+    // Slots are never reused within a game: a removed unit leaves a tombstone behind.
+    class UnitStorage
+    {
+    private:
+        std::vector<int32_t> _ids;
+        std::vector<UnitType> _types;
+        std::vector<uint32_t> _statsIndices;
+        std::vector<Position> _positions;
+        std::vector<std::optional<Position>> _targets;
+        std::vector<int32_t> _hp;
+        std::vector<int32_t> _maxHp;
+        std::vector<uint8_t> _removed;
+
+        template <typename TAllStats>
+        struct StatsPools;
+
+        template <typename... TStats>
+        struct StatsPools<std::tuple<TStats...>>
+        {
+            using Type = std::tuple<std::vector<TStats>...>;
+        };
+
+        StatsPools<AllUnitStats>::Type _stats; // One pool per unit type
+
+        std::unordered_map<int32_t, UnitSlot> _slotsById;
+
+        // Units whose HP dropped to zero since the last cleanup, in the order they died
+        std::vector<UnitSlot> _dead;
+        size_t _activeCount = 0;
+
+    public:
+        // Number of slots ever handed out, including removed units
+        UnitSlot getSlotCount() const { return static_cast<UnitSlot>(_ids.size()); }
+
+        // Number of units that have not been removed
+        size_t size() const { return _slotsById.size(); }
+
+        // Number of units that are still on the map and have HP left
+        size_t getActiveCount() const { return _activeCount; }
+
+        const std::vector<UnitSlot>& getDeadUnits() const { return _dead; }
+        void clearDeadUnits() { _dead.clear(); }
+
+        bool contains(int32_t unitId) const { return _slotsById.find(unitId) != _slotsById.end(); }
+
+        std::optional<UnitSlot> findSlot(int32_t unitId) const
+        {
+            auto it = _slotsById.find(unitId);
+            if (it == _slotsById.end())
+            {
+                return std::nullopt;
+            }
+            return it->second;
+        }
+
+        template <typename TStats>
+        UnitSlot add(int32_t unitId, const Position& position, int32_t hp, const TStats& stats)
+        {
+            auto& pool = std::get<std::vector<TStats>>(_stats);
+            const auto slot = getSlotCount();
+
+            _ids.push_back(unitId);
+            _types.push_back(TStats::Type);
+            _statsIndices.push_back(static_cast<uint32_t>(pool.size()));
+            _positions.push_back(position);
+            _targets.emplace_back(std::nullopt);
+            _hp.push_back(hp);
+            _maxHp.push_back(hp);
+            _removed.push_back(0);
+            pool.push_back(stats);
+
+            _slotsById.emplace(unitId, slot);
+            if (hp > 0)
+            {
+                ++_activeCount;
+            }
+            else
+            {
+                _dead.push_back(slot);
+            }
+            return slot;
+        }
+
+        void remove(UnitSlot slot)
+        {
+            if (isActive(slot))
+            {
+                --_activeCount;
+            }
+            _removed[slot] = 1;
+            _slotsById.erase(_ids[slot]);
+        }
+
+        bool isRemoved(UnitSlot slot) const { return _removed[slot] != 0; }
+
+        // A unit acts while it is on the map and has HP left
+        bool isActive(UnitSlot slot) const { return _removed[slot] == 0 && _hp[slot] > 0; }
+
+        int32_t getId(UnitSlot slot) const { return _ids[slot]; }
+        UnitType getType(UnitSlot slot) const { return _types[slot]; }
+
+        const Position& getPosition(UnitSlot slot) const { return _positions[slot]; }
+        void setPosition(UnitSlot slot, const Position& position) { _positions[slot] = position; }
+
+        const std::optional<Position>& getTarget(UnitSlot slot) const { return _targets[slot]; }
+        void setTarget(UnitSlot slot, const std::optional<Position>& target) { _targets[slot] = target; }
+
+        int32_t getHp(UnitSlot slot) const { return _hp[slot]; }
+        int32_t getMaxHp(UnitSlot slot) const { return _maxHp[slot]; }
+        // Units restored from a snapshot may have lost HP before they were saved
+        void setMaxHp(UnitSlot slot, int32_t maxHp) { _maxHp[slot] = maxHp; }
+        // Keeps the active counter and the dead list up to date as HP crosses zero
+        void setHp(UnitSlot slot, int32_t hp)
+        {
+            const bool wasAlive = _hp[slot] > 0;
+            _hp[slot] = hp;
+
+            if (wasAlive && hp <= 0)
+            {
+                --_activeCount;
+                _dead.push_back(slot);
+            }
+            else if (!wasAlive && hp > 0)
+            {
+                // Healed before being removed; the stale dead list entry is skipped at cleanup
+                ++_activeCount;
+            }
+        }
+
+        template <typename TStats>
+        const TStats& getStats(UnitSlot slot) const
+        {
+            return std::get<std::vector<TStats>>(_stats)[_statsIndices[slot]];
+        }
+    };
+}
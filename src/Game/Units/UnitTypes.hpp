@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CombatUnit.hpp"
+#include "Hunter.hpp"
+#include "Swordsman.hpp"
+#include <concepts>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sw::game
+{
+    // Every unit class, in UnitType order. A new unit type adds its enumerator and stats in
+    // UnitStats.hpp and its class here; dispatch, storage and snapshots pick it up from the lists.
+    using UnitClasses = std::tuple<Swordsman, Hunter>;
+
+    template <size_t... Indices>
+    constexpr bool classesMatchStats(std::index_sequence<Indices...>)
+    {
+        return ((std::is_same_v<typename std::tuple_element_t<Indices, UnitClasses>::Stats, std::tuple_element_t<Indices, AllUnitStats>>) && ...);
+    }
+
+    template <size_t... Indices>
+    constexpr bool classesTakeDamage(std::index_sequence<Indices...>)
+    {
+        return (std::derived_from<std::tuple_element_t<Indices, UnitClasses>, CombatUnit> && ...);
+    }
+
+    static_assert(std::tuple_size_v<UnitClasses> == UNIT_TYPE_COUNT, "Every unit type needs a class");
+    static_assert(classesMatchStats(std::make_index_sequence<UNIT_TYPE_COUNT>{}), "UnitClasses must follow UnitType order");
+    // Attacks may pick any unit as their target, so every unit has to be able to take damage
+    static_assert(classesTakeDamage(std::make_index_sequence<UNIT_TYPE_COUNT>{}), "Every unit class must be a CombatUnit");
+
+    // Calls visitor(std::type_identity<TUnit>{}) with the class of the given unit type.
+    // Expands to a chain of comparisons the compiler can turn into a jump table and inline through.
+    template <size_t Index = 0, typename TVisitor>
+    decltype(auto) visitUnitType(UnitType type, TVisitor&& visitor)
+    {
+        using TUnit = std::tuple_element_t<Index, UnitClasses>;
+        if constexpr (Index + 1 == UNIT_TYPE_COUNT)
+        {
+            return visitor(std::type_identity<TUnit>{});
+        }
+        else
+        {
+            if (static_cast<size_t>(type) == Index)
+            {
+                return visitor(std::type_identity<TUnit>{});
+            }
+            return visitUnitType<Index + 1>(type, std::forward<TVisitor>(visitor));
+        }
+    }
+}
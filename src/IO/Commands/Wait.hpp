@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+
+namespace sw::io
+{
+	// The commands after this one take effect the given number of ticks later
+	struct Wait
+	{
+		constexpr static const char* Name = "WAIT";
+
+		uint32_t ticks{};
+
+		template <typename Visitor>
+		void visit(Visitor& visitor)
+		{
+			visitor.visit("ticks", ticks);
+		}
+	};
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "MapCreated.hpp"
+#include "MarchEnded.hpp"
+#include "MarchStarted.hpp"
+#include "UnitAttacked.hpp"
+#include "UnitDied.hpp"
+#include "UnitMoved.hpp"
+#include "UnitSpawned.hpp"
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+namespace sw::io
+{
+	// Every event the simulation can log. Binary logs identify events by their index in this list.
+	using EventTypes = std::tuple<MapCreated, UnitSpawned, MarchStarted, MarchEnded, UnitMoved, UnitAttacked, UnitDied>;
+
+	template <class TEvent, class TList = EventTypes>
+	struct EventIndex;
+
+	template <class TEvent, class... TEvents>
+	struct EventIndex<TEvent, std::tuple<TEvents...>>
+	{
+		static constexpr size_t value = []
+		{
+			constexpr bool matches[] = {std::is_same_v<TEvent, TEvents>...};
+			for (size_t i = 0; i < sizeof...(TEvents); ++i)
+			{
+				if (matches[i])
+				{
+					return i;
+				}
+			}
+			return sizeof...(TEvents);
+		}();
+
+		static_assert(value < sizeof...(TEvents), "Event is not listed in EventTypes");
+	};
+
+	template <class TEvent>
+	constexpr size_t EventIndexOf = EventIndex<std::decay_t<TEvent>>::value;
+}
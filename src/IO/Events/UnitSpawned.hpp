@@ -1,7 +1,7 @@
 #pragma once
 
 #include <cstdint>
-#include <string>
+#include <string_view>
 
 namespace sw::io
 {
@@ -10,7 +10,7 @@ namespace sw::io
 		constexpr static const char* Name = "UNIT_SPAWNED";
 
 		uint32_t unitId{};
-		std::string unitType{};
+		std::string_view unitType{};
 		uint32_t x{};
 		uint32_t y{};
 
@@ -0,0 +1,236 @@
+#include "AsyncWriter.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace sw
+{
+	AsyncWriter::AsyncWriter(int fd, const Options& options) :
+			_fd(fd),
+			_buffer(std::bit_ceil(std::max<size_t>(options.bufferSize, 4096))),
+			_mask(_buffer.size() - 1)
+	{
+		_thread = std::thread([this] { run(); });
+	}
+
+	AsyncWriter::~AsyncWriter()
+	{
+		close();
+	}
+
+	void AsyncWriter::write(const char* data, size_t size)
+	{
+		while (size > 0)
+		{
+			checkFailure();
+
+			const size_t tail = _tail.load(std::memory_order_relaxed);
+			const size_t head = _head.load(std::memory_order_acquire);
+			const size_t space = _buffer.size() - (tail - head);
+			if (space == 0)
+			{
+				waitForSpace(head);
+				continue;
+			}
+
+			const size_t chunk = std::min(size, space);
+			const size_t offset = tail & _mask;
+			const size_t firstPart = std::min(chunk, _buffer.size() - offset);
+			std::memcpy(&_buffer[offset], data, firstPart);
+			std::memcpy(&_buffer[0], data + firstPart, chunk - firstPart);
+
+			_tail.store(tail + chunk, std::memory_order_seq_cst);
+			wakeWriter();
+
+			data += chunk;
+			size -= chunk;
+		}
+	}
+
+	void AsyncWriter::flush()
+	{
+		const size_t tail = _tail.load(std::memory_order_relaxed);
+		for (size_t head = _head.load(std::memory_order_acquire); head != tail; head = _head.load(std::memory_order_acquire))
+		{
+			checkFailure();
+			waitForSpace(head);
+		}
+		checkFailure();
+	}
+
+	void AsyncWriter::close()
+	{
+		if (!_thread.joinable())
+		{
+			return;
+		}
+
+		{
+			std::lock_guard lock(_mutex);
+			_closing.store(true, std::memory_order_seq_cst);
+		}
+		_dataReady.notify_one();
+		_thread.join();
+	}
+
+	void AsyncWriter::run()
+	{
+		while (true)
+		{
+			const size_t head = _head.load(std::memory_order_relaxed);
+			const size_t tail = _tail.load(std::memory_order_acquire);
+
+			if (head == tail)
+			{
+				if (_closing.load(std::memory_order_acquire) && _tail.load(std::memory_order_acquire) == head)
+				{
+					return;
+				}
+
+				std::unique_lock lock(_mutex);
+				_writerWaiting.store(true, std::memory_order_seq_cst);
+				_dataReady.wait(lock, [this, head]
+				{
+					return _tail.load(std::memory_order_seq_cst) != head || _closing.load(std::memory_order_seq_cst);
+				});
+				_writerWaiting.store(false, std::memory_order_relaxed);
+				continue;
+			}
+
+			// Write the contiguous part of the pending bytes; a wrapped rest goes out on the next pass
+			const size_t offset = head & _mask;
+			const size_t size = std::min(tail - head, _buffer.size() - offset);
+			size_t written = 0;
+			while (written < size && _error.load(std::memory_order_relaxed) == 0)
+			{
+				const ssize_t result = ::write(_fd, &_buffer[offset + written], size - written);
+				if (result < 0 && errno == EINTR)
+				{
+					continue;
+				}
+				if (result <= 0)
+				{
+					_error.store(result < 0 ? errno : EIO, std::memory_order_seq_cst);
+					break;
+				}
+				written += static_cast<size_t>(result);
+			}
+
+			// After a failure the remaining output is discarded so the producer never blocks forever
+			_head.store(head + size, std::memory_order_seq_cst);
+			wakeProducer();
+		}
+	}
+
+	void AsyncWriter::waitForSpace(size_t observedHead)
+	{
+		std::unique_lock lock(_mutex);
+		_producerWaiting.store(true, std::memory_order_seq_cst);
+		_spaceReady.wait(lock, [this, observedHead]
+		{
+			return _head.load(std::memory_order_seq_cst) != observedHead;
+		});
+		_producerWaiting.store(false, std::memory_order_relaxed);
+	}
+
+	void AsyncWriter::wakeWriter()
+	{
+		if (_writerWaiting.load(std::memory_order_seq_cst))
+		{
+			std::lock_guard lock(_mutex);
+			_dataReady.notify_one();
+		}
+	}
+
+	void AsyncWriter::wakeProducer()
+	{
+		if (_producerWaiting.load(std::memory_order_seq_cst))
+		{
+			std::lock_guard lock(_mutex);
+			_spaceReady.notify_one();
+		}
+	}
+
+	void AsyncWriter::checkFailure() const
+	{
+		if (const int error = _error.load(std::memory_order_relaxed); error != 0)
+		{
+			throw std::runtime_error("Failed to write output: " + std::string(std::strerror(error)));
+		}
+	}
+
+	AsyncStreamBuf::AsyncStreamBuf(AsyncWriter& writer, size_t blockSize) :
+			_writer(writer),
+			_block(std::max<size_t>(blockSize, 1))
+	{
+		setp(_block.data(), _block.data() + _block.size());
+	}
+
+	AsyncStreamBuf::~AsyncStreamBuf()
+	{
+		handOver();
+	}
+
+	AsyncStreamBuf::int_type AsyncStreamBuf::overflow(int_type ch)
+	{
+		handOver();
+		if (!traits_type::eq_int_type(ch, traits_type::eof()))
+		{
+			*pptr() = traits_type::to_char_type(ch);
+			pbump(1);
+		}
+		return traits_type::not_eof(ch);
+	}
+
+	int AsyncStreamBuf::sync()
+	{
+		handOver();
+		return 0;
+	}
+
+	void AsyncStreamBuf::handOver()
+	{
+		if (pptr() != pbase())
+		{
+			_writer.write(pbase(), static_cast<size_t>(pptr() - pbase()));
+			setp(_block.data(), _block.data() + _block.size());
+		}
+	}
+
+	AsyncLogStream::AsyncLogStream(int fd, const AsyncWriter::Options& options, size_t blockSize) :
+			std::ostream(nullptr),
+			_writer(std::make_unique<AsyncWriter>(fd, options)),
+			_streamBuf(std::make_unique<AsyncStreamBuf>(*_writer, blockSize))
+	{
+		rdbuf(_streamBuf.get());
+	}
+
+	AsyncLogStream::~AsyncLogStream()
+	{
+		try
+		{
+			close();
+		}
+		catch (...)
+		{
+			// Nothing sensible left to report the failure to
+		}
+	}
+
+	void AsyncLogStream::close()
+	{
+		if (_closed)
+		{
+			return;
+		}
+
+		_closed = true;
+		_streamBuf->pubsync();
+		_writer->flush();
+		_writer->close();
+	}
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+namespace sw
+{
+	// Moves output off the simulation thread.
+	// The producer copies bytes into a single-producer/single-consumer ring buffer, and a background
+	// thread drains it to a file descriptor in as large writes as are available.
+	// Backpressure: when the ring is full the producer blocks until the writer frees enough space,
+	// so output is never dropped or reordered.
+	class AsyncWriter
+	{
+	public:
+		struct Options
+		{
+			size_t bufferSize = size_t{1} << 22; // Rounded up to a power of two
+		};
+
+	private:
+		int _fd;
+		std::vector<char> _buffer;
+		size_t _mask;
+
+		alignas(64) std::atomic<size_t> _head{0}; // Next byte the writer thread will write out
+		alignas(64) std::atomic<size_t> _tail{0}; // Next byte the producer will fill
+
+		std::atomic<bool> _writerWaiting{false};
+		std::atomic<bool> _producerWaiting{false};
+		std::atomic<bool> _closing{false};
+		std::atomic<int> _error{0}; // errno of the first failed write
+		std::mutex _mutex;
+		std::condition_variable _dataReady;
+		std::condition_variable _spaceReady;
+		std::thread _thread;
+
+	public:
+		AsyncWriter(int fd, const Options& options);
+		~AsyncWriter();
+
+		AsyncWriter(const AsyncWriter&) = delete;
+		AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+		void write(const char* data, size_t size);
+
+		// Blocks until everything written so far has reached the file descriptor
+		void flush();
+
+		// Flushes and stops the writer thread. Called by the destructor if not called before.
+		void close();
+
+	private:
+		void run();
+		void waitForSpace(size_t observedHead);
+		void wakeWriter();
+		void wakeProducer();
+		void checkFailure() const;
+	};
+
+	// std::streambuf over an AsyncWriter, so existing stream code can write through it.
+	// Output collects in a local block and is handed to the writer when the block fills up or on flush.
+	class AsyncStreamBuf : public std::streambuf
+	{
+	private:
+		AsyncWriter& _writer;
+		std::vector<char> _block;
+
+	public:
+		AsyncStreamBuf(AsyncWriter& writer, size_t blockSize);
+		~AsyncStreamBuf() override;
+
+	protected:
+		int_type overflow(int_type ch) override;
+		int sync() override;
+
+	private:
+		void handOver();
+	};
+
+	// Output stream that writes to a file descriptor through an AsyncWriter
+	class AsyncLogStream : public std::ostream
+	{
+	private:
+		std::unique_ptr<AsyncWriter> _writer;
+		std::unique_ptr<AsyncStreamBuf> _streamBuf;
+		bool _closed = false;
+
+	public:
+		AsyncLogStream(int fd, const AsyncWriter::Options& options, size_t blockSize = size_t{1} << 16);
+		~AsyncLogStream() override;
+
+		// Flushes everything and stops the writer thread
+		void close();
+	};
+}
@@ -0,0 +1,97 @@
+#include "BinaryEventDecoder.hpp"
+
+#include "details/BinaryFormat.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace sw
+{
+	namespace
+	{
+		struct FieldSchema
+		{
+			std::string name;
+			binary::FieldKind kind;
+		};
+
+		struct EventSchema
+		{
+			std::string name;
+			std::vector<FieldSchema> fields;
+			std::vector<uint64_t> previousValues;
+		};
+
+		std::vector<EventSchema> readSchemas(binary::Reader& reader)
+		{
+			std::vector<EventSchema> events(reader.readVarint());
+			for (auto& event : events)
+			{
+				event.name = reader.readString();
+				event.fields.resize(reader.readVarint());
+				for (auto& field : event.fields)
+				{
+					field.name = reader.readString();
+					const uint64_t kind = reader.readVarint();
+					if (kind > static_cast<uint64_t>(binary::FieldKind::String))
+					{
+						throw std::runtime_error("Binary log has an unknown field kind");
+					}
+					field.kind = static_cast<binary::FieldKind>(kind);
+				}
+				event.previousValues.assign(event.fields.size(), 0);
+			}
+			return events;
+		}
+	}
+
+	void decodeBinaryEventLog(std::string_view data, std::ostream& output)
+	{
+		binary::Reader reader(data.data(), data.data() + data.size());
+		reader.expect(binary::Magic, sizeof(binary::Magic));
+		if (reader.readVarint() != binary::Version)
+		{
+			throw std::runtime_error("Unsupported binary log version");
+		}
+
+		std::vector<EventSchema> events = readSchemas(reader);
+		uint64_t tick = 0;
+		while (!reader.atEnd())
+		{
+			const uint64_t index = reader.readVarint();
+			if (index >= events.size())
+			{
+				throw std::runtime_error("Binary log refers to an unknown event");
+			}
+			EventSchema& event = events[index];
+			tick += static_cast<uint64_t>(binary::unzigzag(reader.readVarint()));
+
+			output << "[" << tick << "] " << event.name << " ";
+			for (size_t i = 0; i < event.fields.size(); ++i)
+			{
+				const FieldSchema& field = event.fields[i];
+				output << field.name << "=";
+				if (field.kind == binary::FieldKind::String)
+				{
+					output << reader.readString();
+				}
+				else
+				{
+					uint64_t& value = event.previousValues[i];
+					value += static_cast<uint64_t>(binary::unzigzag(reader.readVarint()));
+					if (field.kind == binary::FieldKind::Signed)
+					{
+						output << static_cast<int64_t>(value);
+					}
+					else
+					{
+						output << value;
+					}
+				}
+				output << ' ';
+			}
+			output << '\n';
+		}
+	}
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <ostream>
+#include <string_view>
+
+namespace sw
+{
+	// Converts a binary event log written by BinaryEventLog back into the text event log,
+	// line for line identical to what EventLog prints for the same events.
+	// Only the schema stored in the log is used, so the compiled event types do not matter.
+	// Throws std::runtime_error on malformed input.
+	void decodeBinaryEventLog(std::string_view data, std::ostream& output);
+}
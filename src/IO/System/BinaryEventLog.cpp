@@ -0,0 +1,69 @@
+#include "BinaryEventLog.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace sw
+{
+	namespace
+	{
+		template <class TEvent>
+		void writeSchema(std::vector<char>& output, std::vector<std::vector<uint64_t>>& previousValues)
+		{
+			std::vector<std::pair<std::string, binary::FieldKind>> fields;
+			binary::SchemaVisitor visitor(fields);
+			TEvent event;
+			event.visit(visitor);
+
+			binary::writeString(output, TEvent::Name);
+			binary::writeVarint(output, fields.size());
+			for (const auto& [name, kind] : fields)
+			{
+				binary::writeString(output, name);
+				binary::writeVarint(output, static_cast<uint64_t>(kind));
+			}
+			previousValues.emplace_back(fields.size(), 0);
+		}
+
+		template <class... TEvents>
+		void writeSchemas(std::vector<char>& output, std::vector<std::vector<uint64_t>>& previousValues, std::tuple<TEvents...>*)
+		{
+			binary::writeVarint(output, sizeof...(TEvents));
+			(writeSchema<TEvents>(output, previousValues), ...);
+		}
+	}
+
+	BinaryEventLog::BinaryEventLog(std::ostream& stream) :
+			_stream(stream)
+	{
+		_buffer.reserve(FlushThreshold * 2);
+		_buffer.insert(_buffer.end(), std::begin(binary::Magic), std::end(binary::Magic));
+		binary::writeVarint(_buffer, binary::Version);
+		writeSchemas(_buffer, _previousValues, static_cast<io::EventTypes*>(nullptr));
+	}
+
+	BinaryEventLog::~BinaryEventLog()
+	{
+		try
+		{
+			flush();
+		}
+		catch (...)
+		{
+			// Nothing sensible left to report the failure to
+		}
+	}
+
+	void BinaryEventLog::flush()
+	{
+		_stream.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+		_buffer.clear();
+		_stream.flush();
+		if (!_stream)
+		{
+			throw std::runtime_error("Failed to write the binary event log");
+		}
+	}
+}
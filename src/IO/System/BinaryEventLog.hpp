@@ -0,0 +1,51 @@
+#pragma once
+
+#include "details/BinaryFieldVisitor.hpp"
+#include "details/BinaryFormat.hpp"
+#include <IO/Events/EventTypes.hpp>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace sw
+{
+	// Writes events in the compact binary format described in details/BinaryFormat.hpp.
+	// The schema written up front is taken from the visit() of every type in io::EventTypes,
+	// so sw_battle_decode can turn the log back into the text event log without knowing the types.
+	class BinaryEventLog
+	{
+	private:
+		static constexpr size_t FlushThreshold = size_t{1} << 16;
+
+		std::ostream& _stream;
+		std::vector<char> _buffer;
+		uint64_t _lastTick = 0;
+		std::vector<std::vector<uint64_t>> _previousValues; // Per event type, per field
+
+	public:
+		explicit BinaryEventLog(std::ostream& stream);
+		~BinaryEventLog();
+
+		BinaryEventLog(const BinaryEventLog&) = delete;
+		BinaryEventLog& operator=(const BinaryEventLog&) = delete;
+
+		template <class TEvent>
+		void log(uint64_t tick, TEvent& event)
+		{
+			constexpr size_t index = io::EventIndexOf<TEvent>;
+			binary::writeVarint(_buffer, index);
+			binary::writeVarint(_buffer, binary::zigzag(static_cast<int64_t>(tick - _lastTick)));
+			_lastTick = tick;
+
+			binary::EncodeFieldVisitor visitor(_buffer, _previousValues[index]);
+			event.visit(visitor);
+
+			if (_buffer.size() >= FlushThreshold)
+			{
+				flush();
+			}
+		}
+
+		void flush();
+	};
+}
@@ -1,33 +1,34 @@
 #include "CommandParser.hpp"
 
+#include "MappedFile.hpp"
+#include <istream>
+#include <iterator>
+
 namespace sw::io
 {
-	void CommandParser::parse(std::istream& stream)
+	void CommandParser::parse(std::string_view text)
 	{
-		std::string line;
-		while (std::getline(stream, line))
+		forEachCommandLine(text, [this](CommandLine& line, std::string_view commandName)
 		{
-			if (line.rfind("//", 0) == 0 || line.empty())
-			{
-				continue;
-			}
-
-			std::istringstream commandStream(line);
-			std::string commandName;
-			commandStream >> commandName;
-
-			if (commandName.empty())
-			{
-				continue;
-			}
-
 			auto command = _commands.find(commandName);
 			if (command == _commands.end())
 			{
-				throw std::runtime_error("Unknown command: " + commandName);
+				line.fail("Unknown command: " + std::string(commandName));
 			}
 
-			command->second(commandStream);
-		}
+			command->second(line);
+		});
+	}
+
+	void CommandParser::parse(std::istream& stream)
+	{
+		const std::string text((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+		parse(std::string_view(text));
+	}
+
+	void CommandParser::parseFile(const std::string& path)
+	{
+		const MappedFile file(path);
+		parse(file.getText());
 	}
 }
@@ -1,17 +1,28 @@
 #pragma once
 
+#include "details/CommandLine.hpp"
 #include "details/CommandParserVisitor.hpp"
 
 #include <functional>
-#include <sstream>
+#include <iosfwd>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 namespace sw::io
 {
 	class CommandParser
 	{
 	private:
-		std::unordered_map<std::string, std::function<void(std::istream&)>> _commands;
+		// Looks names up by string_view, so no key is built per line
+		struct NameHash
+		{
+			using is_transparent = void;
+
+			size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+		};
+
+		std::unordered_map<std::string, std::function<void(CommandLine&)>, NameHash, std::equal_to<>> _commands;
 
 	public:
 		template <class TCommandData>
@@ -20,10 +31,10 @@ namespace sw::io
 			std::string commandName = TCommandData::Name;
 			auto [it, inserted] = _commands.emplace(
 				commandName,
-				[handler = std::move(handler)](std::istream& stream)
+				[handler = std::move(handler)](CommandLine& line)
 				{
 					TCommandData data;
-					CommandParserVisitor visitor(stream);
+					CommandParserVisitor visitor(line);
 					data.visit(visitor);
 					handler(std::move(data));
 				});
@@ -35,6 +46,12 @@ namespace sw::io
 			return *this;
 		}
 
+		// Parses a whole command file held in memory, e.g. a MappedFile
+		void parse(std::string_view text);
+
 		void parse(std::istream& stream);
+
+		// Memory-maps the file and parses it in place
+		void parseFile(const std::string& path);
 	};
 }
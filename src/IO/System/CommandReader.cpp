@@ -0,0 +1,89 @@
+#include "CommandReader.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sw
+{
+	CommandReader::CommandReader(const std::string& path) :
+			_path(path)
+	{
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			throw std::runtime_error("Error: File not found - " + path);
+		}
+
+		struct stat info{};
+		if (::fstat(fd, &info) != 0)
+		{
+			::close(fd);
+			throw std::runtime_error("Error: Cannot read file - " + path);
+		}
+
+		if (S_ISREG(info.st_mode))
+		{
+			::close(fd);
+			_file.emplace(path);
+		}
+		else
+		{
+			_fd = fd;
+		}
+	}
+
+	CommandReader::~CommandReader()
+	{
+		if (_fd >= 0)
+		{
+			::close(_fd);
+		}
+	}
+
+	std::string_view CommandReader::next()
+	{
+		if (_file)
+		{
+			if (_ended)
+			{
+				return {};
+			}
+			_ended = true;
+			return _file->getText();
+		}
+
+		// What was handed out last time has been parsed; keep only the unfinished line after it
+		_buffer.erase(0, _handedOut);
+		_handedOut = 0;
+
+		constexpr size_t CHUNK = 64 * 1024;
+		size_t searched = 0;
+		while (!_ended)
+		{
+			const size_t lineEnd = _buffer.find('\n', searched);
+			if (lineEnd != std::string::npos)
+			{
+				_handedOut = _buffer.rfind('\n') + 1;
+				return std::string_view(_buffer).substr(0, _handedOut);
+			}
+			searched = _buffer.size();
+
+			_buffer.resize(searched + CHUNK);
+			const ssize_t count = ::read(_fd, _buffer.data() + searched, CHUNK);
+			if (count < 0 && errno != EINTR)
+			{
+				throw std::runtime_error("Error: Cannot read file - " + _path);
+			}
+			_buffer.resize(searched + static_cast<size_t>(std::max<ssize_t>(count, 0)));
+			_ended = count == 0;
+		}
+
+		// The last line needs no newline
+		_handedOut = _buffer.size();
+		return _buffer;
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "MappedFile.hpp"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace sw
+{
+	// Source of a command file's text for CommandStream. A regular file is mapped whole; anything
+	// else, such as a pipe or a FIFO, is read as it arrives, so the commands at its start can be
+	// applied while the writer is still producing the rest.
+	class CommandReader
+	{
+	private:
+		std::optional<MappedFile> _file;
+		int _fd = -1;
+		std::string _path;
+		std::string _buffer;
+		size_t _handedOut = 0; // Bytes at the start of the buffer already returned by next()
+		bool _ended = false;
+
+	public:
+		explicit CommandReader(const std::string& path);
+		~CommandReader();
+
+		CommandReader(const CommandReader&) = delete;
+		CommandReader& operator=(const CommandReader&) = delete;
+
+		// The whole lines that came after the text of the previous call. Waits for at least one
+		// to arrive; empty once the input has ended. The text stays valid until the next call.
+		std::string_view next();
+	};
+}
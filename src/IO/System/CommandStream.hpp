@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CommandReader.hpp"
+#include "details/CommandLine.hpp"
+#include <IO/Commands/Wait.hpp>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace sw::io
+{
+	// Hands the commands of a script to the simulation as their ticks come due.
+	// WAIT n delays the commands after it by n ticks. The text is parsed only as far as the
+	// current tick, so a long script never has to be held as parsed commands. Given a CommandReader,
+	// the text is also read only as far as needed, so a script coming down a pipe plays out as it arrives.
+	template <class TParser, class THandler>
+	class CommandStream
+	{
+	private:
+		const TParser& _parser;
+		THandler _handler;
+		CommandCursor _cursor;
+		CommandReader* _reader = nullptr; // Source of the text after the cursor's, if there is more
+		uint64_t _dueTick = 0; // Tick at which the command at the cursor takes effect
+
+	public:
+		CommandStream(const TParser& parser, std::string_view text, THandler handler) :
+				_parser(parser),
+				_handler(std::move(handler)),
+				_cursor(text)
+		{}
+
+		CommandStream(const TParser& parser, CommandReader& reader, THandler handler) :
+				_parser(parser),
+				_handler(std::move(handler)),
+				_cursor(std::string_view()),
+				_reader(&reader)
+		{}
+
+		// Applies the commands due by the tick. Returns whether the script has more.
+		bool feed(uint64_t tick)
+		{
+			while (_dueTick <= tick)
+			{
+				const bool read = _parser.parseNext(_cursor, [this, tick](auto command)
+				{
+					if constexpr (std::is_same_v<decltype(command), Wait>)
+					{
+						_dueTick = tick + command.ticks;
+					}
+					_handler(command);
+				});
+				if (!read && !refill())
+				{
+					break;
+				}
+			}
+
+			// Whether more is to come; from a reader that takes waiting for its next line
+			while (_cursor.atEnd() && refill())
+			{
+			}
+			return !_cursor.atEnd();
+		}
+
+	private:
+		// Moves the cursor on to the reader's next lines. False once the input has ended.
+		bool refill()
+		{
+			if (!_reader)
+			{
+				return false;
+			}
+
+			const std::string_view text = _reader->next();
+			_cursor.continueWith(text);
+			return !text.empty();
+		}
+	};
+}
@@ -1,22 +1,123 @@
 #pragma once
 
+#include "BinaryEventLog.hpp"
+#include "TextEventLog.hpp"
 #include "details/PrintFieldVisitor.hpp"
-#include <iostream>
-#include <typeindex>
-#include <unordered_map>
+#include <IO/Events/EventTypes.hpp>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 namespace sw
 {
+	// Publishes every logged event to the sinks subscribed to its type.
+	// A sink is an object with log(tick, TEvent&) for the types it takes, such as TextEventLog and
+	// BinaryEventLog, or a callback for one type. Sinks are called in the order they subscribed and
+	// must not change the event. Types nobody subscribed to are dropped after a single bit test, and
+	// GameState tests isSubscribed() before it builds an event.
 	class EventLog
 	{
+	private:
+		static constexpr size_t EventCount = std::tuple_size_v<io::EventTypes>;
+		static_assert(EventCount <= 64, "Subscriptions are tracked in a 64-bit mask");
+
+		using Handler = std::function<void(uint64_t tick, void* event)>;
+
+		std::array<std::vector<Handler>, EventCount> _handlers; // Per event type, in io::EventTypes order
+		uint64_t _subscribed = 0;
+
 	public:
+		// No sinks yet: every event is dropped until something subscribes
+		EventLog() = default;
+
+		// Writes every event to the stream as text
+		explicit EventLog(std::ostream& stream)
+		{
+			subscribeEach(static_cast<io::EventTypes*>(nullptr), [&stream](uint64_t tick, auto& event)
+			{
+				// No per-event flush: the stream decides when to hand its buffer over
+				stream << "[" << tick << "] " << std::decay_t<decltype(event)>::Name << " ";
+				PrintFieldVisitor visitor(stream);
+				event.visit(visitor);
+				stream << '\n';
+			});
+		}
+
+		// Same text as a stream gets, formatted into the text log's buffer
+		explicit EventLog(TextEventLog& textLog) { subscribeAll(textLog); }
+
+		// Events are written to the binary log instead of a text stream
+		explicit EventLog(BinaryEventLog& binaryLog) { subscribeAll(binaryLog); }
+
+		// Drops every event
+		static EventLog discard() { return EventLog(); }
+
+		// Sends the events of the listed types to sink.log(tick, event). The sink must outlive the log.
+		template <class... TEvents, class TSink>
+		EventLog& subscribe(TSink& sink)
+		{
+			(addHandler<TEvents>([&sink](uint64_t tick, TEvents& event) { sink.log(tick, event); }), ...);
+			return *this;
+		}
+
+		// Sends every event type to the sink
+		template <class TSink>
+		EventLog& subscribeAll(TSink& sink)
+		{
+			subscribeEach(static_cast<io::EventTypes*>(nullptr), [&sink](uint64_t tick, auto& event) { sink.log(tick, event); });
+			return *this;
+		}
+
+		// Calls callback(tick, event) for every event of one type
+		template <class TEvent, class TCallback>
+		EventLog& onEvent(TCallback callback)
+		{
+			addHandler<TEvent>(std::move(callback));
+			return *this;
+		}
+
+		template <class TEvent>
+		bool isSubscribed() const
+		{
+			return (_subscribed >> io::EventIndexOf<TEvent>) & 1;
+		}
+
 		template <class TEvent>
 		void log(uint64_t tick, TEvent&& event)
 		{
-			std::cout << "[" << tick << "] " << TEvent::Name << " ";
-			PrintFieldVisitor visitor(std::cout);
-			event.visit(visitor);
-			std::cout << std::endl;
+			using Event = std::decay_t<TEvent>;
+			if (!isSubscribed<Event>())
+			{
+				return;
+			}
+
+			for (const Handler& handler : _handlers[io::EventIndexOf<Event>])
+			{
+				handler(tick, &event);
+			}
+		}
+
+	private:
+		template <class TEvent, class TCallback>
+		void addHandler(TCallback callback)
+		{
+			constexpr size_t index = io::EventIndexOf<TEvent>;
+			_handlers[index].emplace_back([callback = std::move(callback)](uint64_t tick, void* event) mutable
+			{
+				callback(tick, *static_cast<TEvent*>(event));
+			});
+			_subscribed |= uint64_t{1} << index;
+		}
+
+		// Subscribes a generic callback(tick, auto& event) to each of the listed types
+		template <class... TEvents, class TCallback>
+		void subscribeEach(std::tuple<TEvents...>*, const TCallback& callback)
+		{
+			(addHandler<TEvents>([callback](uint64_t tick, TEvents& event) mutable { callback(tick, event); }), ...);
 		}
 	};
 }
@@ -0,0 +1,100 @@
+#include "MappedFile.hpp"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sw
+{
+	MappedFile::MappedFile(const std::string& path)
+	{
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			throw std::runtime_error("Error: File not found - " + path);
+		}
+
+		try
+		{
+			struct stat info{};
+			if (::fstat(fd, &info) != 0)
+			{
+				throw std::runtime_error("Error: Cannot read file - " + path);
+			}
+
+			// Pipes, FIFOs and terminals report no size, so only a regular file can be mapped
+			if (S_ISREG(info.st_mode))
+			{
+				map(fd, static_cast<size_t>(info.st_size), path);
+			}
+			else
+			{
+				readAll(fd, path);
+			}
+		}
+		catch (...)
+		{
+			::close(fd);
+			throw;
+		}
+		// The mapping keeps the file alive on its own
+		::close(fd);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (_mapped)
+		{
+			::munmap(const_cast<char*>(_data), _size);
+		}
+	}
+
+	void MappedFile::map(int fd, size_t size, const std::string& path)
+	{
+		if (size == 0)
+		{
+			return;
+		}
+
+		void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED)
+		{
+			throw std::runtime_error("Error: Cannot map file - " + path);
+		}
+		::madvise(data, size, MADV_SEQUENTIAL);
+		_data = static_cast<const char*>(data);
+		_size = size;
+		_mapped = true;
+	}
+
+	void MappedFile::readAll(int fd, const std::string& path)
+	{
+		constexpr size_t CHUNK = 64 * 1024;
+
+		size_t used = 0;
+		while (true)
+		{
+			_buffer.resize(used + CHUNK);
+			const ssize_t count = ::read(fd, _buffer.data() + used, CHUNK);
+			if (count < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				throw std::runtime_error("Error: Cannot read file - " + path);
+			}
+			if (count == 0)
+			{
+				break;
+			}
+			used += static_cast<size_t>(count);
+		}
+		_buffer.resize(used);
+		_data = _buffer.data();
+		_size = used;
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace sw
+{
+	// Read-only memory mapping of a whole file. The text stays valid while the object lives.
+	// Anything that cannot be mapped, such as a pipe or a FIFO, is read to its end into a buffer.
+	class MappedFile
+	{
+	private:
+		const char* _data = nullptr;
+		size_t _size = 0;
+		bool _mapped = false;
+		std::string _buffer; // Holds the text when it was read instead of mapped
+
+	public:
+		explicit MappedFile(const std::string& path);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		std::string_view getText() const { return {_data, _size}; }
+
+	private:
+		void map(int fd, size_t size, const std::string& path);
+		void readAll(int fd, const std::string& path);
+	};
+}
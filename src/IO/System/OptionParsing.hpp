@@ -0,0 +1,51 @@
+#pragma once
+
+#include <charconv>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace sw
+{
+	// Value of a numeric option; the whole text must be a number that fits the type
+	template <typename TValue>
+	TValue parseNumber(std::string_view option, std::string_view text)
+	{
+		TValue value{};
+		auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+		if (error != std::errc() || end != text.data() + text.size())
+		{
+			throw std::runtime_error("Error: Invalid value for " + std::string(option) + ": " + std::string(text));
+		}
+		return value;
+	}
+
+	// Walks the arguments of a program, an option and its value at a time
+	class ArgumentList
+	{
+	private:
+		int _argc;
+		char** _argv;
+		int _next = 1; // Past the program name
+
+	public:
+		ArgumentList(int argc, char** argv) :
+				_argc(argc),
+				_argv(argv)
+		{}
+
+		bool atEnd() const { return _next >= _argc; }
+
+		std::string_view next() { return _argv[_next++]; }
+
+		// The argument after an option, which takes it as its value
+		std::string_view valueOf(std::string_view option)
+		{
+			if (atEnd())
+			{
+				throw std::runtime_error("Error: Missing value for " + std::string(option));
+			}
+			return next();
+		}
+	};
+}
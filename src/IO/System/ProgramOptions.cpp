@@ -0,0 +1,77 @@
+#include "ProgramOptions.hpp"
+
+#include "OptionParsing.hpp"
+#include <stdexcept>
+#include <string_view>
+
+namespace sw
+{
+	ProgramOptions ProgramOptions::parse(int argc, char** argv)
+	{
+		ProgramOptions options;
+
+		ArgumentList arguments(argc, argv);
+		while (!arguments.atEnd())
+		{
+			const std::string_view argument = arguments.next();
+
+			if (argument == "--async-log")
+			{
+				options.asyncLog = true;
+			}
+			else if (argument == "--log-buffer")
+			{
+				options.asyncWriter.bufferSize = parseNumber<size_t>(argument, arguments.valueOf(argument));
+			}
+			else if (argument == "--binary-log")
+			{
+				options.binaryLogPath = arguments.valueOf(argument);
+			}
+			else if (argument == "--seed")
+			{
+				options.seed = parseNumber<uint64_t>(argument, arguments.valueOf(argument));
+			}
+			else if (argument == "--threads")
+			{
+				options.threads = parseNumber<size_t>(argument, arguments.valueOf(argument));
+			}
+			else if (argument == "--profile")
+			{
+				options.profilePath = arguments.valueOf(argument);
+			}
+			else if (argument == "--snapshot-every")
+			{
+				options.snapshotInterval = parseNumber<uint64_t>(argument, arguments.valueOf(argument));
+			}
+			else if (argument == "--snapshot-prefix")
+			{
+				options.snapshotPrefix = arguments.valueOf(argument);
+			}
+			else if (argument == "--restore")
+			{
+				options.restorePath = arguments.valueOf(argument);
+			}
+			else if (argument.rfind("--", 0) == 0)
+			{
+				throw std::runtime_error("Error: Unknown option " + std::string(argument));
+			}
+			else if (options.scenarioPath.empty())
+			{
+				options.scenarioPath = argument;
+			}
+			else
+			{
+				throw std::runtime_error("Error: Unexpected argument " + std::string(argument));
+			}
+		}
+
+		if (options.scenarioPath.empty() == options.restorePath.empty())
+		{
+			throw std::runtime_error(options.scenarioPath.empty()
+				? "Error: No file specified in command line argument"
+				: "Error: --restore replaces the scenario file");
+		}
+
+		return options;
+	}
+}
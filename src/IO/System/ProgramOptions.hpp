@@ -0,0 +1,37 @@
+#pragma once
+
+#include "AsyncWriter.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace sw
+{
+	// Command line of the simulator: sw_battle_test [options] <scenario file>
+	// or, to resume a saved battle, sw_battle_test [options] --restore <snapshot>
+	struct ProgramOptions
+	{
+		std::string scenarioPath;
+
+		// --async-log: write output from a background thread
+		bool asyncLog = false;
+		// --log-buffer <bytes>: ring buffer size of the background writer
+		AsyncWriter::Options asyncWriter;
+		// --binary-log <path>: write events to a binary log instead of stdout (see sw_battle_decode)
+		std::string binaryLogPath;
+		// --seed <n>: seed of the simulation's random numbers; the same seed replays the same battle
+		std::optional<uint64_t> seed;
+		// --threads <n>: threads deciding unit actions, 0 for one per hardware thread
+		size_t threads = 1;
+		// --profile <path>: write per-tick timings and counters, as CSV if the path ends in .csv, else JSON
+		std::string profilePath;
+		// --snapshot-every <n>: save the battle at the start of every n-th tick
+		uint64_t snapshotInterval = 0;
+		// --snapshot-prefix <path>: snapshots go to <path><tick>.snap
+		std::string snapshotPrefix = "snapshot-";
+		// --restore <path>: continue a battle saved with --snapshot-every instead of running a scenario
+		std::string restorePath;
+
+		static ProgramOptions parse(int argc, char** argv);
+	};
+}
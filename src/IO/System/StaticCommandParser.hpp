@@ -0,0 +1,144 @@
+#pragma once
+
+#include "details/CommandLine.hpp"
+#include "details/CommandParserVisitor.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace sw::io
+{
+	// Handler built from several lambdas, one per command type
+	template <class... TLambdas>
+	struct Overloaded : TLambdas...
+	{
+		using TLambdas::operator()...;
+	};
+
+	template <class... TLambdas>
+	Overloaded(TLambdas...) -> Overloaded<TLambdas...>;
+
+	// Command parser for a set of command types fixed at compile time:
+	//
+	//     StaticCommandParser<CreateMap, SpawnSwordsman, SpawnHunter, March> parser;
+	//     parser.parse(text, handler); // handler(CreateMap), handler(March), ...
+	//
+	// Names are looked up in a collision-free hash table built from each command's Name at compile
+	// time, and the handler is called directly, so it can be inlined. For handlers registered at
+	// runtime use CommandParser.
+	template <class... TCommands>
+	class StaticCommandParser
+	{
+	private:
+		static constexpr size_t CommandCount = sizeof...(TCommands);
+		static constexpr std::array<std::string_view, CommandCount> Names{std::string_view(TCommands::Name)...};
+
+		static constexpr uint64_t hashName(std::string_view name)
+		{
+			uint64_t hash = 14695981039346656037ull; // FNV-1a
+			for (char c : name)
+			{
+				hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+			}
+			return hash;
+		}
+
+		// Smallest power of two at which no two names share a slot
+		static constexpr size_t findTableSize()
+		{
+			for (size_t size = 1; size <= 1024; size *= 2)
+			{
+				if (size < CommandCount)
+				{
+					continue;
+				}
+
+				std::array<bool, 1024> used{};
+				bool collision = false;
+				for (std::string_view name : Names)
+				{
+					const size_t slot = hashName(name) & (size - 1);
+					collision = collision || used[slot];
+					used[slot] = true;
+				}
+				if (!collision)
+				{
+					return size;
+				}
+			}
+			return 0;
+		}
+
+		static constexpr size_t TableSize = findTableSize();
+		static_assert(CommandCount > 0 && CommandCount < 256, "StaticCommandParser needs 1 to 255 command types");
+		static_assert(TableSize != 0, "Command names must be unique");
+
+		// Command index + 1 per slot, 0 for an empty slot
+		static constexpr std::array<uint8_t, TableSize> Table = []
+		{
+			std::array<uint8_t, TableSize> table{};
+			for (size_t i = 0; i < CommandCount; ++i)
+			{
+				table[hashName(Names[i]) & (TableSize - 1)] = static_cast<uint8_t>(i + 1);
+			}
+			return table;
+		}();
+
+	public:
+		// Index of the command type in TCommands, or the number of command types if the name is unknown
+		static size_t findCommand(std::string_view name)
+		{
+			const uint8_t entry = Table[hashName(name) & (TableSize - 1)];
+			if (entry == 0 || Names[entry - 1] != name)
+			{
+				return CommandCount;
+			}
+			return entry - 1;
+		}
+
+		template <class THandler>
+		void parse(std::string_view text, THandler&& handler) const
+		{
+			CommandCursor cursor(text);
+			while (parseNext(cursor, handler))
+			{
+			}
+		}
+
+		// Parses the command at the cursor; false once the text is used up
+		template <class THandler>
+		bool parseNext(CommandCursor& cursor, THandler&& handler) const
+		{
+			return cursor.readCommand([&handler](CommandLine& line, std::string_view commandName)
+			{
+				const size_t index = findCommand(commandName);
+				if (index == CommandCount)
+				{
+					line.fail("Unknown command: " + std::string(commandName));
+				}
+
+				dispatch(index, line, handler, std::index_sequence_for<TCommands...>{});
+			});
+		}
+
+	private:
+		template <class THandler, size_t... Indices>
+		static void dispatch(size_t index, CommandLine& line, THandler& handler, std::index_sequence<Indices...>)
+		{
+			// Folds into a switch over the command index
+			((index == Indices ? (parseCommand<TCommands>(line, handler), true) : false) || ...);
+		}
+
+		template <class TCommandData, class THandler>
+		static void parseCommand(CommandLine& line, THandler& handler)
+		{
+			TCommandData data;
+			CommandParserVisitor visitor(line);
+			data.visit(visitor);
+			handler(std::move(data));
+		}
+	};
+}
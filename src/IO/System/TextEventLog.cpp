@@ -0,0 +1,38 @@
+#include "TextEventLog.hpp"
+
+#include <stdexcept>
+
+namespace sw
+{
+	TextEventLog::TextEventLog(std::ostream& stream) :
+			_stream(stream),
+			_buffer(std::make_unique<char[]>(BufferSize))
+	{}
+
+	TextEventLog::~TextEventLog()
+	{
+		try
+		{
+			flush();
+		}
+		catch (...)
+		{
+			// Nothing sensible left to report the failure to
+		}
+	}
+
+	void TextEventLog::flush()
+	{
+		if (_used == 0)
+		{
+			return;
+		}
+
+		_stream.write(_buffer.get(), static_cast<std::streamsize>(_used));
+		_used = 0;
+		if (!_stream)
+		{
+			throw std::runtime_error("Failed to write the event log");
+		}
+	}
+}
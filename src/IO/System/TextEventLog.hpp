@@ -0,0 +1,135 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+namespace sw
+{
+	// Writes the text event log, "[tick] NAME field=value ... \n", byte for byte as EventLog does
+	// on a plain stream, but without going through operator<<. Field names come from visit() as
+	// string literals whose lengths are known at compile time, numbers are formatted with
+	// std::to_chars, and the text collects in a buffer that is written to the stream in large blocks.
+	// Anything else written to the same stream has to go through print() or follow a flush(),
+	// otherwise it overtakes the buffered events.
+	class TextEventLog
+	{
+	private:
+		static constexpr size_t BufferSize = size_t{1} << 16;
+		static constexpr size_t MaxNumberLength = 20; // Digits of the largest 64-bit value, or a sign and 19 digits
+
+		std::ostream& _stream;
+		std::unique_ptr<char[]> _buffer;
+		size_t _used = 0;
+
+		class FieldVisitor
+		{
+		private:
+			TextEventLog& _log;
+
+		public:
+			explicit FieldVisitor(TextEventLog& log) :
+					_log(log)
+			{}
+
+			template <size_t NameSize, typename T>
+			void visit(const char (&name)[NameSize], const T& value)
+			{
+				const std::string_view fieldName(name, NameSize - 1);
+				if constexpr (std::is_integral_v<T>)
+				{
+					static_assert(!std::is_same_v<T, char> && !std::is_same_v<T, bool>, "Text fields are numbers or strings");
+					_log.reserve(fieldName.size() + MaxNumberLength + 2);
+					_log.put(fieldName);
+					_log.put('=');
+					_log.putNumber(value);
+					_log.put(' ');
+				}
+				else
+				{
+					const std::string_view text(value);
+					_log.reserve(fieldName.size() + 1);
+					_log.put(fieldName);
+					_log.put('=');
+					_log.append(text);
+					_log.reserve(1);
+					_log.put(' ');
+				}
+			}
+		};
+
+	public:
+		explicit TextEventLog(std::ostream& stream);
+		~TextEventLog();
+
+		TextEventLog(const TextEventLog&) = delete;
+		TextEventLog& operator=(const TextEventLog&) = delete;
+
+		template <class TEvent>
+		void log(uint64_t tick, TEvent& event)
+		{
+			reserve(MaxNumberLength + 3);
+			put('[');
+			putNumber(tick);
+			put("] ");
+			print(event);
+		}
+
+		// Writes a command or an event without its tick, in printDebug()'s format
+		template <class TData>
+		void print(TData& data)
+		{
+			constexpr std::string_view name = TData::Name;
+			append(name);
+			reserve(1);
+			put(' ');
+			FieldVisitor visitor(*this);
+			data.visit(visitor);
+			reserve(1);
+			put('\n');
+		}
+
+		void flush();
+
+	private:
+		// Makes room for size more bytes; sizes above BufferSize only ever go through append()
+		void reserve(size_t size)
+		{
+			if (BufferSize - _used < size)
+			{
+				flush();
+			}
+		}
+
+		// The put functions expect the room to have been reserved
+		void put(char c) { _buffer[_used++] = c; }
+
+		void put(std::string_view text)
+		{
+			std::memcpy(_buffer.get() + _used, text.data(), text.size());
+			_used += text.size();
+		}
+
+		template <typename T>
+		void putNumber(T value)
+		{
+			char* begin = _buffer.get() + _used;
+			_used = static_cast<size_t>(std::to_chars(begin, begin + MaxNumberLength, value).ptr - _buffer.get());
+		}
+
+		void append(std::string_view text)
+		{
+			reserve(text.size());
+			if (text.size() > BufferSize)
+			{
+				_stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+				return;
+			}
+			put(text);
+		}
+	};
+}
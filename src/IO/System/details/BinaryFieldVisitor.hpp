@@ -0,0 +1,75 @@
+#pragma once
+
+#include "BinaryFormat.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sw::binary
+{
+	template <typename T>
+	constexpr FieldKind fieldKindOf()
+	{
+		if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
+		{
+			return FieldKind::String;
+		}
+		else
+		{
+			static_assert(std::is_integral_v<T>, "Binary event log supports integer and string fields");
+			return std::is_signed_v<T> ? FieldKind::Signed : FieldKind::Unsigned;
+		}
+	}
+
+	// Collects the field list of an event from its visit()
+	class SchemaVisitor
+	{
+	private:
+		std::vector<std::pair<std::string, FieldKind>>& _fields;
+
+	public:
+		explicit SchemaVisitor(std::vector<std::pair<std::string, FieldKind>>& fields) :
+				_fields(fields)
+		{}
+
+		template <typename T>
+		void visit(const char* name, const T&)
+		{
+			_fields.emplace_back(name, fieldKindOf<T>());
+		}
+	};
+
+	// Appends the fields of one event, delta-encoding integers against the previous event of the same type
+	class EncodeFieldVisitor
+	{
+	private:
+		std::vector<char>& _output;
+		std::vector<uint64_t>& _previous;
+		size_t _field = 0;
+
+	public:
+		EncodeFieldVisitor(std::vector<char>& output, std::vector<uint64_t>& previous) :
+				_output(output),
+				_previous(previous)
+		{}
+
+		template <typename T>
+		void visit(const char*, const T& value)
+		{
+			if constexpr (fieldKindOf<T>() == FieldKind::String)
+			{
+				writeString(_output, value);
+			}
+			else
+			{
+				const auto current = static_cast<uint64_t>(static_cast<std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>(value));
+				writeVarint(_output, zigzag(static_cast<int64_t>(current - _previous[_field])));
+				_previous[_field] = current;
+			}
+			++_field;
+		}
+	};
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace sw::binary
+{
+	// Layout of a binary event log:
+	//   header:  "SWBL", version, schema
+	//   schema:  event count, then per event its name and fields (name + kind)
+	//   records: event index, tick delta, then the event's fields in visit() order
+	// Integers are LEB128 varints. Integer fields are zig-zag deltas against the previous value
+	// of the same field of the same event; strings are a length followed by the bytes.
+	constexpr char Magic[4] = {'S', 'W', 'B', 'L'};
+	constexpr uint64_t Version = 1;
+
+	enum class FieldKind : uint8_t
+	{
+		Unsigned = 0,
+		Signed = 1,
+		String = 2
+	};
+
+	template <typename TOutput>
+	void writeVarint(TOutput& output, uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			output.push_back(static_cast<char>(value | 0x80));
+			value >>= 7;
+		}
+		output.push_back(static_cast<char>(value));
+	}
+
+	template <typename TOutput>
+	void writeString(TOutput& output, std::string_view value)
+	{
+		writeVarint(output, value.size());
+		output.insert(output.end(), value.begin(), value.end());
+	}
+
+	inline uint64_t zigzag(int64_t value)
+	{
+		return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+	}
+
+	inline int64_t unzigzag(uint64_t value)
+	{
+		return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+	}
+
+	// Sequential reader over an in-memory binary log
+	class Reader
+	{
+	private:
+		const char* _position;
+		const char* _end;
+
+	public:
+		Reader(const char* begin, const char* end) :
+				_position(begin),
+				_end(end)
+		{}
+
+		bool atEnd() const { return _position == _end; }
+
+		uint64_t readVarint()
+		{
+			uint64_t value = 0;
+			for (int shift = 0; shift < 64; shift += 7)
+			{
+				if (_position == _end)
+				{
+					throw std::runtime_error("Binary log is truncated");
+				}
+				const auto byte = static_cast<uint8_t>(*_position++);
+				value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+				if ((byte & 0x80) == 0)
+				{
+					return value;
+				}
+			}
+			throw std::runtime_error("Binary log has a malformed varint");
+		}
+
+		std::string readString()
+		{
+			const uint64_t size = readVarint();
+			if (size > static_cast<uint64_t>(_end - _position))
+			{
+				throw std::runtime_error("Binary log is truncated");
+			}
+			std::string value(_position, static_cast<size_t>(size));
+			_position += size;
+			return value;
+		}
+
+		void expect(const char* bytes, size_t size)
+		{
+			if (static_cast<size_t>(_end - _position) < size || std::string(_position, size) != std::string(bytes, size))
+			{
+				throw std::runtime_error("Not a binary event log");
+			}
+			_position += size;
+		}
+	};
+}
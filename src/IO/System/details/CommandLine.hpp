@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace sw
+{
+	// Thrown for a malformed command; line and column are 1-based
+	class CommandParseError : public std::runtime_error
+	{
+	private:
+		size_t _line;
+		size_t _column;
+
+	public:
+		CommandParseError(size_t line, size_t column, const std::string& message) :
+				std::runtime_error("Error: line " + std::to_string(line) + ", column " + std::to_string(column) + ": " + message),
+				_line(line),
+				_column(column)
+		{}
+
+		size_t getLine() const { return _line; }
+		size_t getColumn() const { return _column; }
+	};
+
+	// Splits one line of a command file into whitespace-separated tokens without copying it
+	class CommandLine
+	{
+	private:
+		std::string_view _text;
+		size_t _lineNumber;
+		size_t _position = 0;
+		size_t _tokenStart = 0;
+
+	public:
+		CommandLine(std::string_view text, size_t lineNumber) :
+				_text(text),
+				_lineNumber(lineNumber)
+		{}
+
+		// Empty once the line is used up
+		std::string_view nextToken()
+		{
+			while (_position < _text.size() && isSpace(_text[_position]))
+			{
+				++_position;
+			}
+			_tokenStart = _position;
+			while (_position < _text.size() && !isSpace(_text[_position]))
+			{
+				++_position;
+			}
+			return _text.substr(_tokenStart, _position - _tokenStart);
+		}
+
+		// Error pointing at the start of the last token, or at the end of the line if there was none
+		[[noreturn]] void fail(const std::string& message) const
+		{
+			throw CommandParseError(_lineNumber, _tokenStart + 1, message);
+		}
+
+	private:
+		static bool isSpace(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+		}
+	};
+
+	// Position in a command file. Reads it one command at a time, skipping empty and "//" lines.
+	class CommandCursor
+	{
+	private:
+		std::string_view _text;
+		size_t _lineNumber = 0;
+
+	public:
+		explicit CommandCursor(std::string_view text) :
+				_text(text)
+		{}
+
+		bool atEnd() const { return _text.empty(); }
+
+		// 1-based line of the command read last
+		size_t getLineNumber() const { return _lineNumber; }
+
+		// Goes on with the next part of the same file once this one is used up; line numbers carry on
+		void continueWith(std::string_view text) { _text = text; }
+
+		// Calls callback(CommandLine&, std::string_view commandName) for the next command, with the
+		// line positioned after the name. Returns false if there was none left.
+		template <class TCallback>
+		bool readCommand(TCallback&& callback)
+		{
+			while (!_text.empty())
+			{
+				++_lineNumber;
+				const size_t lineEnd = _text.find('\n');
+				const std::string_view lineText = _text.substr(0, lineEnd);
+				_text.remove_prefix(lineEnd == std::string_view::npos ? _text.size() : lineEnd + 1);
+
+				if (lineText.starts_with("//"))
+				{
+					continue;
+				}
+
+				CommandLine line(lineText, _lineNumber);
+				const std::string_view commandName = line.nextToken();
+				if (!commandName.empty())
+				{
+					callback(line, commandName);
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+	// Calls callback(CommandLine&, std::string_view commandName) for every command of a command file
+	template <class TCallback>
+	void forEachCommandLine(std::string_view text, TCallback&& callback)
+	{
+		CommandCursor cursor(text);
+		while (cursor.readCommand(callback))
+		{
+		}
+	}
+}
@@ -1,23 +1,46 @@
 #pragma once
 
-#include <iostream>
+#include "CommandLine.hpp"
+#include <charconv>
+#include <string>
+#include <type_traits>
 
 namespace sw
 {
+	// Reads the fields of a command from the rest of its line.
+	// Integers go through std::from_chars: no locale, no stream state, no allocation.
 	class CommandParserVisitor
 	{
 	private:
-		std::istream& _stream;
+		CommandLine& _line;
 
 	public:
-		CommandParserVisitor(std::istream& stream) :
-				_stream(stream)
+		explicit CommandParserVisitor(CommandLine& line) :
+				_line(line)
 		{}
 
 		template <class TField>
-		void visit(const char*, TField& field)
+		void visit(const char* name, TField& field)
 		{
-			_stream >> field;
+			const std::string_view token = _line.nextToken();
+			if (token.empty())
+			{
+				_line.fail(std::string("missing value for ") + name);
+			}
+
+			if constexpr (std::is_same_v<TField, std::string>)
+			{
+				field = token;
+			}
+			else
+			{
+				static_assert(std::is_integral_v<TField>, "Command fields are integers or strings");
+				auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), field);
+				if (error != std::errc() || end != token.data() + token.size())
+				{
+					_line.fail(std::string("invalid value for ") + name + ": " + std::string(token));
+				}
+			}
 		}
 	};
 }
@@ -2,6 +2,7 @@
 #include <IO/Commands/March.hpp>
 #include <IO/Commands/SpawnHunter.hpp>
 #include <IO/Commands/SpawnSwordsman.hpp>
+#include <IO/Commands/Wait.hpp>
 #include <IO/Events/MapCreated.hpp>
 #include <IO/Events/MarchEnded.hpp>
 #include <IO/Events/MarchStarted.hpp>
@@ -9,59 +10,209 @@
 #include <IO/Events/UnitDied.hpp>
 #include <IO/Events/UnitMoved.hpp>
 #include <IO/Events/UnitSpawned.hpp>
-#include <IO/System/CommandParser.hpp>
+#include <IO/System/BinaryEventLog.hpp>
+#include <IO/System/CommandReader.hpp>
+#include <IO/System/CommandStream.hpp>
 #include <IO/System/EventLog.hpp>
+#include <IO/System/MappedFile.hpp>
 #include <IO/System/PrintDebug.hpp>
+#include <IO/System/ProgramOptions.hpp>
+#include <IO/System/StaticCommandParser.hpp>
+#include <IO/System/TextEventLog.hpp>
 #include <Game/GameController.hpp>
+#include <Game/Parallel/ThreadPool.hpp>
+#include <Game/Profiling/Profiler.hpp>
+#include <Game/Snapshot/SnapshotWriter.hpp>
 #include <fstream>
 #include <iostream>
+#include <optional>
+#include <random>
+#include <unistd.h>
 
 int main(int argc, char** argv)
 {
 	using namespace sw;
 
-	if (argc != 2)
+	const auto options = ProgramOptions::parse(argc, argv);
+
+	// A scenario is read as the simulation needs it, so it may come down a pipe while the battle runs
+	const bool restoring = !options.restorePath.empty();
+	std::optional<MappedFile> snapshot;
+	std::optional<CommandReader> scenario;
+	if (restoring)
+	{
+		snapshot.emplace(options.restorePath);
+	}
+	else
+	{
+		scenario.emplace(options.scenarioPath);
+	}
+
+	// All output goes through one stream so command echoes and events stay in order
+	std::optional<AsyncLogStream> asyncOutput;
+	if (options.asyncLog)
+	{
+		std::cout.flush();
+		asyncOutput.emplace(STDOUT_FILENO, options.asyncWriter);
+	}
+	std::ostream& output = asyncOutput ? static_cast<std::ostream&>(*asyncOutput) : std::cout;
+
+	std::ofstream binaryFile;
+	std::optional<BinaryEventLog> binaryLog;
+	if (!options.binaryLogPath.empty())
+	{
+		binaryFile.open(options.binaryLogPath, std::ios::binary);
+		if (!binaryFile)
+		{
+			throw std::runtime_error("Error: Cannot open binary log - " + options.binaryLogPath);
+		}
+		binaryLog.emplace(binaryFile);
+	}
+
+	std::ofstream profileFile;
+	std::optional<game::Profiler> profiler;
+	if (!options.profilePath.empty())
 	{
-		throw std::runtime_error("Error: No file specified in command line argument");
+		if (!game::PROFILING_COMPILED)
+		{
+			throw std::runtime_error("Error: --profile needs a build with SW_PROFILING enabled");
+		}
+		profileFile.open(options.profilePath);
+		if (!profileFile)
+		{
+			throw std::runtime_error("Error: Cannot open profile - " + options.profilePath);
+		}
+		profiler.emplace();
 	}
 
-	std::ifstream file(argv[1]);
-	if (!file)
+	// Text events are buffered, so command echoes that go to the same output are buffered with them
+	std::optional<TextEventLog> textLog;
+	if (!binaryLog)
 	{
-		throw std::runtime_error("Error: File not found - " + std::string(argv[1]));
+		textLog.emplace(output);
 	}
+	auto echo = [&output, &textLog](auto& command)
+	{
+		if (textLog)
+		{
+			textLog->print(command);
+		}
+		else
+		{
+			printDebug(output, command);
+		}
+	};
+
+	try
+	{
+		output << "Commands:\n";
+		
+		EventLog eventLog = binaryLog ? EventLog(*binaryLog) : EventLog(*textLog);
+		std::optional<game::ThreadPool> threadPool;
+		if (options.threads != 1)
+		{
+			threadPool.emplace(options.threads);
+		}
 
-	std::cout << "Commands:\n";
-	
-	EventLog eventLog;
-	game::GameController gameController(eventLog);
-	
-	io::CommandParser parser;
-	parser.add<io::CreateMap>([&gameController](auto command) { 
-		printDebug(std::cout, command); 
-		gameController.handleCreateMap(command);
-	})
-	.add<io::SpawnSwordsman>([&gameController](auto command) { 
-		printDebug(std::cout, command); 
-		gameController.handleSpawnSwordsman(command);
-	})
-	.add<io::SpawnHunter>([&gameController](auto command) { 
-		printDebug(std::cout, command); 
-		gameController.handleSpawnHunter(command);
-	})
-	.add<io::March>([&gameController](auto command) { 
-		printDebug(std::cout, command); 
-		gameController.handleMarch(command);
-	});
+		std::random_device randomDevice;
+		game::SimulationOptions simulationOptions;
+		simulationOptions.seed = options.seed.value_or(uint64_t{randomDevice()} << 32 | randomDevice());
+		simulationOptions.threadPool = threadPool ? &*threadPool : nullptr;
+		simulationOptions.profiler = profiler ? &*profiler : nullptr;
+		std::optional<game::SnapshotWriter> snapshots;
+		if (options.snapshotInterval > 0)
+		{
+			snapshots.emplace(options.snapshotInterval, options.snapshotPrefix);
+			simulationOptions.snapshots = &*snapshots;
+		}
+		game::GameController gameController(eventLog, simulationOptions);
+		if (restoring)
+		{
+			gameController.restoreSnapshot(snapshot->getText());
+		}
+		
+		io::StaticCommandParser<io::CreateMap, io::SpawnSwordsman, io::SpawnHunter, io::March, io::Wait> parser;
+		io::Overloaded handleCommand{
+			[&gameController, &echo](io::CreateMap command) { 
+				echo(command); 
+				gameController.handleCreateMap(command);
+			},
+			[&gameController, &echo](io::SpawnSwordsman command) { 
+				echo(command); 
+				gameController.handleSpawnSwordsman(command);
+			},
+			[&gameController, &echo](io::SpawnHunter command) { 
+				echo(command); 
+				gameController.handleSpawnHunter(command);
+			},
+			[&gameController, &echo](io::March command) { 
+				echo(command); 
+				gameController.handleMarch(command);
+			},
+			[&echo](io::Wait command) { 
+				echo(command); 
+			}
+		};
+		auto commands = scenario
+			? io::CommandStream(parser, *scenario, std::move(handleCommand))
+			: io::CommandStream(parser, std::string_view(), std::move(handleCommand));
 
-	parser.parse(file);
+		// Commands up to the first WAIT set up the battle; the rest are fed in as their ticks come
+		commands.feed(1);
 
-	std::cout << "\n\nEvents:\n";
-	
-	// Run simulation after all commands are processed
-	gameController.runSimulation();
+		if (textLog)
+		{
+			textLog->flush();
+		}
+		output << "\n\nEvents:\n";
+		
+		gameController.runSimulation([&commands](uint64_t tick) { return commands.feed(tick); });
+
+		if (textLog)
+		{
+			textLog->flush();
+		}
+		output << "\n\nSimulation ended\n";
+
+		if (profiler)
+		{
+			if (options.profilePath.ends_with(".csv"))
+			{
+				profiler->writeCsv(profileFile);
+			}
+			else
+			{
+				profiler->writeJson(profileFile);
+			}
+		}
+	}
+	catch (...)
+	{
+		// Whatever was logged before the failure still reaches the output
+		if (textLog)
+		{
+			textLog->flush();
+		}
+		output.flush();
+		if (binaryLog)
+		{
+			binaryLog->flush();
+		}
+		if (asyncOutput)
+		{
+			asyncOutput->close();
+		}
+		throw;
+	}
 
-	std::cout << "\n\nSimulation ended\n";
+	if (binaryLog)
+	{
+		binaryLog->flush();
+	}
+	if (asyncOutput)
+	{
+		asyncOutput->close();
+	}
 
 	return 0;
 }
@@ -0,0 +1,76 @@
+// Feeds a script down a pipe and checks CommandStream applies its first commands before the
+// writer has sent the rest. If the stream waited for the whole input, feed(1) would never return.
+
+#include <IO/Commands/CreateMap.hpp>
+#include <IO/Commands/SpawnSwordsman.hpp>
+#include <IO/Commands/Wait.hpp>
+#include <IO/System/CommandReader.hpp>
+#include <IO/System/CommandStream.hpp>
+#include <IO/System/StaticCommandParser.hpp>
+#include <cstdio>
+#include <future>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+
+namespace
+{
+	bool writeAll(int fd, std::string_view text)
+	{
+		return ::write(fd, text.data(), text.size()) == static_cast<ssize_t>(text.size());
+	}
+
+	bool check(bool condition, const char* message)
+	{
+		if (!condition)
+		{
+			std::fprintf(stderr, "%s\n", message);
+		}
+		return condition;
+	}
+}
+
+int main()
+{
+	using namespace sw;
+
+	int fds[2];
+	if (::pipe(fds) != 0)
+	{
+		std::perror("pipe");
+		return 1;
+	}
+
+	std::promise<void> firstPartApplied;
+	std::thread writer([fd = fds[1], applied = firstPartApplied.get_future()]
+	{
+		// The spawn line ends mid-write, so the reader has to put it together across reads
+		writeAll(fd, "CREATE_MAP 10 10\nWAIT 2\nSPAWN_SWORDSMAN 1 0 0 5 2\nSPAWN_SWO");
+		applied.wait();
+		writeAll(fd, "RDSMAN 2 9 9 5 2\nWAIT 1");
+		::close(fd);
+	});
+
+	size_t maps = 0;
+	size_t swordsmen = 0;
+	size_t waits = 0;
+	CommandReader reader("/dev/fd/" + std::to_string(fds[0]));
+	io::StaticCommandParser<io::CreateMap, io::SpawnSwordsman, io::Wait> parser;
+	io::CommandStream commands(parser, reader, io::Overloaded{
+		[&maps](io::CreateMap) { ++maps; },
+		[&swordsmen](io::SpawnSwordsman) { ++swordsmen; },
+		[&waits](io::Wait) { ++waits; }
+	});
+
+	bool passed = check(commands.feed(1), "The script should have more after tick 1");
+	passed &= check(maps == 1 && waits == 1 && swordsmen == 0, "Tick 1 should apply CREATE_MAP and WAIT only");
+	firstPartApplied.set_value();
+
+	passed &= check(!commands.feed(3), "The script should end after tick 3");
+	passed &= check(swordsmen == 2 && waits == 2, "Tick 3 should apply both spawns and the last WAIT");
+
+	writer.join();
+	::close(fds[0]);
+	return passed ? 0 : 1;
+}
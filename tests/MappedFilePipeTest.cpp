@@ -0,0 +1,59 @@
+// Reads a command file through a pipe and checks MappedFile gets the same text as from the file
+
+#include <IO/System/MappedFile.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+int main(int argc, char** argv)
+{
+	using namespace sw;
+
+	if (argc != 2)
+	{
+		std::fprintf(stderr, "Usage: sw_battle_mapped_file_test <command file>\n");
+		return 2;
+	}
+
+	const MappedFile file(argv[1]);
+	const std::string_view expected = file.getText();
+	if (expected.empty())
+	{
+		std::fprintf(stderr, "%s is empty\n", argv[1]);
+		return 1;
+	}
+
+	int fds[2];
+	if (::pipe(fds) != 0)
+	{
+		std::perror("pipe");
+		return 1;
+	}
+
+	// Written in small pieces so the reader sees the text arrive over several reads
+	std::thread writer([&expected, fd = fds[1]]
+	{
+		for (size_t offset = 0; offset < expected.size(); offset += 7)
+		{
+			const size_t count = std::min<size_t>(7, expected.size() - offset);
+			if (::write(fd, expected.data() + offset, count) != static_cast<ssize_t>(count))
+			{
+				break;
+			}
+		}
+		::close(fd);
+	});
+
+	const MappedFile piped("/dev/fd/" + std::to_string(fds[0]));
+	writer.join();
+	::close(fds[0]);
+
+	if (piped.getText() != expected)
+	{
+		std::fprintf(stderr, "Read %zu bytes through the pipe, the file has %zu\n", piped.getText().size(), expected.size());
+		return 1;
+	}
+	return 0;
+}
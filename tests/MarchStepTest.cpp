@@ -0,0 +1,98 @@
+// Pins the stepping rule of marching units: within PathPlanner::FIELD_RADIUS of its target a unit
+// walks around obstacles along the target's flow field, further out it steps straight at the
+// target, and neither depends on how many other units march to the same target.
+
+#include <IO/System/EventLog.hpp>
+#include <Game/GameState.hpp>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+	using namespace sw;
+	using namespace sw::game;
+
+	constexpr int32_t WIDTH = 300;
+	constexpr int32_t HEIGHT = 64;
+	constexpr int32_t MARCHER = 1;
+	constexpr uint64_t TICKS = 10;
+
+	enum class Company
+	{
+		None,      // The marcher is the only unit on its route
+		Far,       // Nine more units march to the same target from the far end of the map
+		Vanishing  // As Far, but they are removed after a few ticks, as if killed
+	};
+
+	// Positions of the marcher over the first ticks of its march from start to target. An idle wall
+	// at x = 30 spans y = 5..40, so the short way round passes below it.
+	std::vector<Position> march(const Position& start, const Position& target, Company company)
+	{
+		EventLog eventLog = EventLog::discard();
+		GameState state(WIDTH, HEIGHT, SimulationOptions{7}, eventLog);
+		int32_t unitId = MARCHER + 1;
+		for (int32_t y = 5; y <= 40; ++y)
+		{
+			state.addUnit<Swordsman>(unitId++, Position(30, y), 100, Swordsman::Stats{1});
+		}
+
+		state.addUnit<Swordsman>(MARCHER, start, 100, Swordsman::Stats{1});
+		state.setMarchTarget(*state.getUnits().findSlot(MARCHER), target);
+		std::vector<int32_t> companions;
+		if (company != Company::None)
+		{
+			for (int32_t i = 0; i < 9; ++i)
+			{
+				companions.push_back(unitId);
+				state.addUnit<Swordsman>(unitId, Position(WIDTH - 1, 2 + 6 * i), 100, Swordsman::Stats{1});
+				state.setMarchTarget(*state.getUnits().findSlot(unitId++), target);
+			}
+		}
+
+		std::vector<Position> path;
+		for (uint64_t tick = 0; tick < TICKS; ++tick)
+		{
+			if (company == Company::Vanishing && tick == 4)
+			{
+				for (int32_t companion : companions)
+				{
+					state.removeUnit(companion);
+				}
+			}
+			state.runTick();
+			state.nextTick();
+			path.push_back(state.getUnits().getPosition(*state.getUnits().findSlot(MARCHER)));
+		}
+		return path;
+	}
+
+	bool check(bool condition, const char* message)
+	{
+		if (!condition)
+		{
+			std::fprintf(stderr, "%s\n", message);
+		}
+		return condition;
+	}
+}
+
+int main()
+{
+	bool passed = true;
+
+	// Close to the target the flow field leads the marcher down round the wall, not straight at it
+	const Position target(40, 25);
+	const auto alone = march(Position(20, 25), target, Company::None);
+	passed &= check(alone.front() == Position(21, 26), "Near the target the first step should head round the wall");
+	passed &= check(alone.back().y > 25 && alone.back().x < 30, "The marcher should still be heading round the wall");
+	passed &= check(march(Position(20, 25), target, Company::Far) == alone, "Units sharing the target should not change the marcher's steps");
+	passed &= check(march(Position(20, 25), target, Company::Vanishing) == alone, "Losing units sharing the target should not change the marcher's steps");
+
+	// Beyond the field radius the marcher steps straight at the target
+	const Position farTarget(target.x + PathPlanner::FIELD_RADIUS + 30, 25);
+	const auto far = march(Position(20, 25), farTarget, Company::None);
+	passed &= check(far.front() == Position(21, 25), "Far from the target the first step should go straight at it");
+	passed &= check(march(Position(20, 25), farTarget, Company::Far) == far, "Units sharing a far target should not change the marcher's steps");
+
+	return passed ? 0 : 1;
+}
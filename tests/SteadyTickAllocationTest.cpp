@@ -0,0 +1,93 @@
+// Runs a marching battle until its containers have grown to their working size, then fails if
+// any further tick allocates. Checked on the calling thread and with a thread pool.
+
+#include <AllocationCounter.hpp>
+#include <IO/System/EventLog.hpp>
+#include <Game/GameState.hpp>
+#include <Game/Parallel/ThreadPool.hpp>
+#include <cstdio>
+#include <random>
+
+namespace
+{
+	using namespace sw;
+	using namespace sw::game;
+
+	constexpr int32_t SIZE = 256;
+	constexpr int32_t UNITS = 4096;
+	constexpr uint64_t WARM_UP_TICKS = 20;
+	constexpr uint64_t CHECKED_TICKS = 50;
+
+	// Both unit types on random free cells, all marching to the centre
+	void populate(GameState& state)
+	{
+		std::mt19937_64 random(42);
+		auto between = [&random](int32_t low, int32_t high)
+		{
+			return std::uniform_int_distribution<int32_t>(low, high)(random);
+		};
+
+		for (int32_t unitId = 1; unitId <= UNITS; ++unitId)
+		{
+			Position position;
+			do
+			{
+				position = Position(between(0, SIZE - 1), between(0, SIZE - 1));
+			}
+			while (state.getMap().isOccupied(position));
+
+			if (unitId % 2 == 0)
+			{
+				state.addUnit<Hunter>(unitId, position, between(10, 20), Hunter::Stats{between(1, 5), between(1, 3), between(2, 6)});
+			}
+			else
+			{
+				state.addUnit<Swordsman>(unitId, position, between(10, 20), Swordsman::Stats{between(1, 5)});
+			}
+			state.setMarchTarget(*state.getUnits().findSlot(unitId), Position(SIZE / 2, SIZE / 2));
+		}
+	}
+
+	bool checkSteadyTicks(ThreadPool* threadPool)
+	{
+		EventLog eventLog = EventLog::discard();
+		GameState state(SIZE, SIZE, SimulationOptions{42, threadPool}, eventLog);
+		populate(state);
+		for (uint64_t tick = 0; tick < WARM_UP_TICKS; ++tick)
+		{
+			state.runTick();
+			state.nextTick();
+		}
+
+		uint64_t active = 0;
+		const uint64_t before = support::allocationCount.load(std::memory_order_relaxed);
+		for (uint64_t tick = 0; tick < CHECKED_TICKS; ++tick)
+		{
+			active += state.runTick();
+			state.nextTick();
+		}
+		const uint64_t allocations = support::allocationCount.load(std::memory_order_relaxed) - before;
+
+		const size_t threads = threadPool ? threadPool->getThreadCount() : 1;
+		if (active == 0)
+		{
+			std::fprintf(stderr, "%zu thread(s): the battle was over before the checked ticks\n", threads);
+			return false;
+		}
+		if (allocations != 0)
+		{
+			std::fprintf(stderr, "%zu thread(s): %llu allocations in %llu steady ticks\n", threads,
+				static_cast<unsigned long long>(allocations), static_cast<unsigned long long>(CHECKED_TICKS));
+			return false;
+		}
+		return true;
+	}
+}
+
+int main()
+{
+	bool passed = checkSteadyTicks(nullptr);
+	ThreadPool threadPool(4);
+	passed &= checkSteadyTicks(&threadPool);
+	return passed ? 0 : 1;
+}
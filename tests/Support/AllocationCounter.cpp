@@ -0,0 +1,70 @@
+// Replacement global allocation functions that count every heap allocation in the process, for
+// the benchmark's allocs_per_op figures and the allocation tests. The whole family is replaced,
+// so every form of new is counted and every form of delete frees with the function its new
+// allocated with. Kept in a unit of its own so no call site can inline an allocation into a
+// mismatched release.
+
+#include "AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+std::atomic<uint64_t> sw::support::allocationCount{0};
+
+namespace
+{
+	void* allocate(std::size_t size) noexcept
+	{
+		sw::support::allocationCount.fetch_add(1, std::memory_order_relaxed);
+		return std::malloc(size == 0 ? 1 : size);
+	}
+
+	void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept
+	{
+		sw::support::allocationCount.fetch_add(1, std::memory_order_relaxed);
+		const auto align = static_cast<std::size_t>(alignment);
+		// aligned_alloc wants a size that is a multiple of the alignment
+		return std::aligned_alloc(align, (size + align - 1) / align * align + (size == 0 ? align : 0));
+	}
+
+	void* allocateOrThrow(std::size_t size)
+	{
+		if (void* memory = allocate(size))
+		{
+			return memory;
+		}
+		throw std::bad_alloc();
+	}
+
+	void* allocateAlignedOrThrow(std::size_t size, std::align_val_t alignment)
+	{
+		if (void* memory = allocateAligned(size, alignment))
+		{
+			return memory;
+		}
+		throw std::bad_alloc();
+	}
+}
+
+void* operator new(std::size_t size) { return allocateOrThrow(size); }
+void* operator new[](std::size_t size) { return allocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateAligned(size, alignment); }
+
+// malloc and aligned_alloc memory are both released with free
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { std::free(memory); }
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace sw::support
+{
+	// Heap allocations so far in the process, counted by the replacement operator new in
+	// AllocationCounter.cpp. Only programs that link the counter have it.
+	extern std::atomic<uint64_t> allocationCount;
+
+	// Leaves the allocations made during its lifetime out of the count, for setup inside a measured body
+	class UncountedAllocations
+	{
+	private:
+		uint64_t _start = allocationCount.load(std::memory_order_relaxed);
+
+	public:
+		UncountedAllocations() = default;
+		UncountedAllocations(const UncountedAllocations&) = delete;
+		UncountedAllocations& operator=(const UncountedAllocations&) = delete;
+
+		~UncountedAllocations()
+		{
+			allocationCount.fetch_sub(allocationCount.load(std::memory_order_relaxed) - _start, std::memory_order_relaxed);
+		}
+	};
+}
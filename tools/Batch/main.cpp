@@ -0,0 +1,148 @@
+#include <IO/Commands/CreateMap.hpp>
+#include <IO/Commands/March.hpp>
+#include <IO/Commands/SpawnHunter.hpp>
+#include <IO/Commands/SpawnSwordsman.hpp>
+#include <IO/Commands/Wait.hpp>
+#include <IO/System/EventLog.hpp>
+#include <IO/System/MappedFile.hpp>
+#include <IO/System/OptionParsing.hpp>
+#include <IO/System/StaticCommandParser.hpp>
+#include <Game/Batch/BatchRunner.hpp>
+#include <Game/GameController.hpp>
+#include <Game/Parallel/ThreadPool.hpp>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace
+{
+	constexpr uint64_t TICK_BUCKET = 50;
+}
+
+// sw_battle_batch [--runs <n>] [--seed <n>] [--threads <n>] <scenario file>
+// Plays the scenario once per seed (seed, seed + 1, ...) without event output and prints how the battles ended.
+// The scenario must be untimed: a script with WAIT is rejected.
+int main(int argc, char** argv)
+{
+	using namespace sw;
+
+	std::string scenarioPath;
+	size_t runs = 1000;
+	std::optional<uint64_t> baseSeed;
+	size_t threads = 0;
+	ArgumentList arguments(argc, argv);
+	while (!arguments.atEnd())
+	{
+		const std::string_view argument = arguments.next();
+
+		if (argument == "--runs")
+		{
+			runs = parseNumber<size_t>(argument, arguments.valueOf(argument));
+		}
+		else if (argument == "--seed")
+		{
+			baseSeed = parseNumber<uint64_t>(argument, arguments.valueOf(argument));
+		}
+		else if (argument == "--threads")
+		{
+			threads = parseNumber<size_t>(argument, arguments.valueOf(argument));
+		}
+		else if (argument.rfind("--", 0) == 0 || !scenarioPath.empty())
+		{
+			throw std::runtime_error("Usage: sw_battle_batch [--runs <n>] [--seed <n>] [--threads <n>] <scenario file>");
+		}
+		else
+		{
+			scenarioPath = argument;
+		}
+	}
+	if (scenarioPath.empty())
+	{
+		throw std::runtime_error("Usage: sw_battle_batch [--runs <n>] [--seed <n>] [--threads <n>] <scenario file>");
+	}
+
+	// The scenario is parsed once; the setup events go nowhere. Every run starts from the state it
+	// sets up, so a timed script (WAIT) cannot be played and is refused rather than cut short.
+	EventLog setupLog = EventLog::discard();
+	game::GameController gameController(setupLog, game::SimulationOptions{});
+	const MappedFile scenario(scenarioPath);
+	io::StaticCommandParser<io::CreateMap, io::SpawnSwordsman, io::SpawnHunter, io::March, io::Wait> parser;
+	CommandCursor cursor(scenario.getText());
+	const io::Overloaded handleCommand{
+		[&gameController](io::CreateMap command) { gameController.handleCreateMap(command); },
+		[&gameController](io::SpawnSwordsman command) { gameController.handleSpawnSwordsman(command); },
+		[&gameController](io::SpawnHunter command) { gameController.handleSpawnHunter(command); },
+		[&gameController](io::March command) { gameController.handleMarch(command); },
+		[&cursor](io::Wait)
+		{
+			throw std::runtime_error("Error: line " + std::to_string(cursor.getLineNumber())
+				+ ": WAIT is not supported; sw_battle_batch plays untimed scenarios only");
+		}
+	};
+	while (parser.parseNext(cursor, handleCommand))
+	{
+	}
+
+	std::random_device randomDevice;
+	const uint64_t firstSeed = baseSeed.value_or(uint64_t{randomDevice()} << 32 | randomDevice());
+	std::vector<uint64_t> seeds(runs);
+	for (size_t i = 0; i < runs; ++i)
+	{
+		seeds[i] = firstSeed + i;
+	}
+
+	game::ThreadPool threadPool(threads);
+	game::BatchRunner runner(gameController.getGameState(), threadPool);
+
+	const auto start = std::chrono::steady_clock::now();
+	const auto outcomes = runner.run(seeds);
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::map<int32_t, size_t> winners;
+	size_t draws = 0;
+	std::map<uint64_t, size_t> tickBuckets;
+	std::map<size_t, size_t> survivors;
+	for (const auto& outcome : outcomes)
+	{
+		if (outcome.winner)
+		{
+			++winners[*outcome.winner];
+		}
+		else
+		{
+			++draws;
+		}
+		++tickBuckets[outcome.ticks / TICK_BUCKET * TICK_BUCKET];
+		++survivors[outcome.survivors];
+	}
+
+	std::cout << "Battles: " << runs << " from seed " << firstSeed << " on " << threadPool.getThreadCount()
+			  << " threads\n";
+	std::cout << "Time: " << elapsed.count() << " s, " << (elapsed.count() > 0 ? runs / elapsed.count() : 0.0)
+			  << " battles/s\n";
+
+	std::cout << "\nWinners:\n";
+	for (const auto& [unitId, count] : winners)
+	{
+		std::cout << "  unit " << unitId << ": " << count << '\n';
+	}
+	std::cout << "  none: " << draws << '\n';
+
+	std::cout << "\nTicks:\n";
+	for (const auto& [bucket, count] : tickBuckets)
+	{
+		std::cout << "  " << bucket << "-" << bucket + TICK_BUCKET - 1 << ": " << count << '\n';
+	}
+
+	std::cout << "\nSurvivors:\n";
+	for (const auto& [count, battles] : survivors)
+	{
+		std::cout << "  " << count << ": " << battles << '\n';
+	}
+
+	return 0;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <AllocationCounter.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace sw::bench
+{
+	// Keeps a computed value alive so the optimizer cannot drop the work that produced it
+	template <typename T>
+	void keep(const T& value)
+	{
+		asm volatile("" : : "r,m"(value) : "memory");
+	}
+
+	struct Result
+	{
+		std::string name;
+		std::vector<std::pair<std::string, int64_t>> params;
+		uint64_t iterations = 0;
+		uint64_t operations = 0;
+		uint64_t allocations = 0; // Made by the body during the run
+		double seconds = 0;
+	};
+
+	// Runs benchmarks and collects their results.
+	// A benchmark body gets an iteration count and returns how many operations it performed, so
+	// one iteration may stand for a batch of operations (e.g. all the lines of a parsed file).
+	class Suite
+	{
+	private:
+		std::string_view _filter;
+		double _minSeconds;
+		std::vector<Result> _results;
+
+	public:
+		Suite(std::string_view filter, double minSeconds) :
+				_filter(filter),
+				_minSeconds(minSeconds)
+		{}
+
+		bool isSelected(std::string_view name) const
+		{
+			return _filter.empty() || name.find(_filter) != std::string_view::npos;
+		}
+
+		// Doubles the iteration count until a run takes at least the minimum time
+		template <typename TBody>
+		void run(std::string name, std::vector<std::pair<std::string, int64_t>> params, TBody&& body)
+		{
+			if (!isSelected(name))
+			{
+				return;
+			}
+
+			Result result{std::move(name), std::move(params)};
+			for (uint64_t iterations = 1;; iterations *= 2)
+			{
+				const uint64_t allocationsBefore = support::allocationCount.load(std::memory_order_relaxed);
+				const auto start = std::chrono::steady_clock::now();
+				const uint64_t operations = body(iterations);
+				const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+				result.iterations = iterations;
+				result.operations = operations;
+				result.allocations = support::allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+				result.seconds = elapsed.count();
+				if (elapsed.count() >= _minSeconds)
+				{
+					break;
+				}
+			}
+			_results.push_back(std::move(result));
+		}
+
+		const std::vector<Result>& getResults() const { return _results; }
+
+		void writeJson(std::ostream& stream) const
+		{
+			stream << "{\n  \"benchmarks\": [";
+			for (size_t i = 0; i < _results.size(); ++i)
+			{
+				const Result& result = _results[i];
+				stream << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << result.name << "\", \"params\": {";
+				for (size_t p = 0; p < result.params.size(); ++p)
+				{
+					stream << (p == 0 ? "" : ", ") << '"' << result.params[p].first << "\": " << result.params[p].second;
+				}
+				const double operations = static_cast<double>(result.operations);
+				stream << "}, \"iterations\": " << result.iterations
+					   << ", \"operations\": " << result.operations
+					   << ", \"seconds\": " << result.seconds
+					   << ", \"ns_per_op\": " << (operations > 0 ? result.seconds * 1e9 / operations : 0.0)
+					   << ", \"ops_per_second\": " << (result.seconds > 0 ? operations / result.seconds : 0.0)
+					   << ", \"allocs_per_op\": " << (operations > 0 ? static_cast<double>(result.allocations) / operations : 0.0) << "}";
+			}
+			stream << "\n  ]\n}\n";
+		}
+	};
+}
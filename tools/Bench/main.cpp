@@ -0,0 +1,489 @@
+#include "Benchmark.hpp"
+
+#include <IO/Commands/CreateMap.hpp>
+#include <IO/Commands/March.hpp>
+#include <IO/Commands/SpawnHunter.hpp>
+#include <IO/Commands/SpawnSwordsman.hpp>
+#include <IO/Events/UnitDied.hpp>
+#include <IO/Events/UnitMoved.hpp>
+#include <IO/System/BinaryEventLog.hpp>
+#include <IO/System/CommandParser.hpp>
+#include <IO/System/EventLog.hpp>
+#include <IO/System/OptionParsing.hpp>
+#include <IO/System/StaticCommandParser.hpp>
+#include <IO/System/TextEventLog.hpp>
+#include <Game/GameState.hpp>
+#include <Game/Parallel/ThreadPool.hpp>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <utility>
+
+using namespace sw;
+using namespace sw::game;
+
+namespace
+{
+	constexpr uint64_t SEED = 42;
+
+	// Swallows everything written to it, so output benchmarks measure formatting only
+	class NullBuffer : public std::streambuf
+	{
+	protected:
+		int overflow(int c) override { return c == traits_type::eof() ? 0 : c; }
+		std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+	};
+
+	struct BattleParams
+	{
+		int32_t size = 0;
+		int32_t units = 0;
+		int32_t hunterPercent = 0;
+		int32_t marchingPercent = 100;
+		bool randomTargets = false;
+	};
+
+	// Spawns units with random stats on random free cells and sends marchingPercent of them towards
+	// the map centre, or each to a cell of its own with randomTargets. The rest stay put and only
+	// fight what comes to them.
+	void populate(GameState& state, const BattleParams& params)
+	{
+		std::mt19937_64 random(SEED);
+		auto between = [&random](int32_t low, int32_t high)
+		{
+			return std::uniform_int_distribution<int32_t>(low, high)(random);
+		};
+
+		const Position centre(params.size / 2, params.size / 2);
+		for (int32_t unitId = 1; unitId <= params.units; ++unitId)
+		{
+			Position position;
+			do
+			{
+				position = Position(between(0, params.size - 1), between(0, params.size - 1));
+			}
+			while (state.getMap().isOccupied(position));
+
+			if (between(0, 99) < params.hunterPercent)
+			{
+				state.addUnit<Hunter>(unitId, position, between(10, 20), Hunter::Stats{between(1, 5), between(1, 3), between(2, 6)});
+			}
+			else
+			{
+				state.addUnit<Swordsman>(unitId, position, between(10, 20), Swordsman::Stats{between(1, 5)});
+			}
+			if (params.marchingPercent >= 100 || between(0, 99) < params.marchingPercent)
+			{
+				const Position target = params.randomTargets ? Position(between(0, params.size - 1), between(0, params.size - 1)) : centre;
+				state.setMarchTarget(*state.getUnits().findSlot(unitId), target);
+			}
+		}
+	}
+
+	std::vector<Position> randomPositions(size_t count, int32_t size)
+	{
+		std::mt19937_64 random(SEED);
+		std::uniform_int_distribution<int32_t> coordinate(0, size - 1);
+		std::vector<Position> positions(count);
+		for (auto& position : positions)
+		{
+			position = Position(coordinate(random), coordinate(random));
+		}
+		return positions;
+	}
+
+	std::string spawnScript(int32_t lines)
+	{
+		std::string text = "CREATE_MAP 4096 4096\n";
+		for (int32_t i = 1; i < lines; ++i)
+		{
+			if (i % 2 == 0)
+			{
+				text += "SPAWN_SWORDSMAN " + std::to_string(i) + " " + std::to_string(i % 4096) + " " + std::to_string(i / 4096) + " 10 2\n";
+			}
+			else
+			{
+				text += "SPAWN_HUNTER " + std::to_string(i) + " " + std::to_string(i % 4096) + " " + std::to_string(i / 4096) + " 10 5 1 4\n";
+			}
+		}
+		return text;
+	}
+
+	void benchmarkMap(bench::Suite& suite)
+	{
+		constexpr int32_t size = 1024;
+		for (Map::Storage storage : {Map::Storage::Dense, Map::Storage::Sparse})
+		{
+			Map map(size, size, storage);
+			const auto positions = randomPositions(4096, size / 2);
+			std::vector<Position> units;
+			for (const auto& position : positions)
+			{
+				// Every unit gets a free cell to its right to step into and back
+				const Position cell(position.x * 2, position.y * 2);
+				if (map.placeUnit(cell, static_cast<UnitSlot>(units.size())))
+				{
+					units.push_back(cell);
+				}
+			}
+
+			suite.run("Map::moveUnit", {{"width", size}, {"height", size}, {"units", static_cast<int64_t>(units.size())}, {"sparse", map.isSparse()}},
+				[&](uint64_t iterations)
+				{
+					size_t moved = 0;
+					for (uint64_t i = 0; i < iterations; ++i)
+					{
+						const Position& from = units[i % units.size()];
+						const Position to(from.x + 1, from.y);
+						moved += map.moveUnit(from, to);
+						moved += map.moveUnit(to, from);
+					}
+					bench::keep(moved);
+					return iterations * 2;
+				});
+
+			suite.run("Map::getOccupiedNeighbours", {{"width", size}, {"height", size}, {"units", static_cast<int64_t>(units.size())}, {"sparse", map.isSparse()}},
+				[&](uint64_t iterations)
+				{
+					uint64_t mask = 0;
+					for (uint64_t i = 0; i < iterations; ++i)
+					{
+						mask += map.getOccupiedNeighbours(units[i % units.size()]);
+					}
+					bench::keep(mask);
+					return iterations;
+				});
+		}
+	}
+
+	void benchmarkQueries(bench::Suite& suite)
+	{
+		for (int32_t units : {1024, 16384})
+		{
+			constexpr int32_t size = 512;
+			EventLog eventLog = EventLog::discard();
+			GameState state(size, size, SimulationOptions{SEED}, eventLog);
+			populate(state, {size, units, 50});
+			const auto centres = randomPositions(1024, size);
+			std::vector<UnitSlot> found;
+
+			for (int32_t range : {2, 5, 10})
+			{
+				suite.run("GameState::getUnitsInRange", {{"width", size}, {"height", size}, {"units", units}, {"range", range}},
+					[&](uint64_t iterations)
+					{
+						size_t count = 0;
+						for (uint64_t i = 0; i < iterations; ++i)
+						{
+							count += state.getUnitsInRange(centres[i % centres.size()], range, found).size();
+						}
+						bench::keep(count);
+						return iterations;
+					});
+			}
+
+			// Hunters with no neighbour are free to shoot, so each of them searches its whole range
+			// for a target with one annulus query
+			std::vector<UnitSlot> hunters;
+			UnitStorage& storage = state.getUnits();
+			for (UnitSlot slot = 0; slot < storage.getSlotCount(); ++slot)
+			{
+				if (storage.getType(slot) == UnitType::Hunter && !state.hasAdjacentUnits(storage.getPosition(slot)))
+				{
+					hunters.push_back(slot);
+				}
+			}
+			suite.run("Hunter::decideRangedAttack", {{"width", size}, {"height", size}, {"units", units}, {"hunters", static_cast<int64_t>(hunters.size())}},
+				[&](uint64_t iterations)
+				{
+					int64_t shots = 0;
+					for (uint64_t i = 0; i < iterations; ++i)
+					{
+						const UnitSlot slot = hunters[i % hunters.size()];
+						RandomStream random = state.getRandomStream(slot);
+						shots += Hunter(storage, slot).decideRangedAttack(state, random).has_value();
+					}
+					bench::keep(shots);
+					return iterations;
+				});
+		}
+	}
+
+	void benchmarkParser(bench::Suite& suite)
+	{
+		constexpr int32_t lines = 100000;
+		const std::string text = spawnScript(lines);
+
+		suite.run("CommandParser::parse", {{"lines", lines}}, [&](uint64_t iterations)
+		{
+			uint64_t sum = 0;
+			io::CommandParser parser;
+			parser.add<io::CreateMap>([&sum](auto command) { sum += command.width; })
+				.add<io::SpawnSwordsman>([&sum](auto command) { sum += command.unitId; })
+				.add<io::SpawnHunter>([&sum](auto command) { sum += command.unitId; })
+				.add<io::March>([&sum](auto command) { sum += command.unitId; });
+			for (uint64_t i = 0; i < iterations; ++i)
+			{
+				parser.parse(std::string_view(text));
+			}
+			bench::keep(sum);
+			return iterations * lines;
+		});
+
+		suite.run("StaticCommandParser::parse", {{"lines", lines}}, [&](uint64_t iterations)
+		{
+			uint64_t sum = 0;
+			io::StaticCommandParser<io::CreateMap, io::SpawnSwordsman, io::SpawnHunter, io::March> parser;
+			for (uint64_t i = 0; i < iterations; ++i)
+			{
+				parser.parse(text, io::Overloaded{
+					[&sum](io::CreateMap command) { sum += command.width; },
+					[&sum](auto command) { sum += command.unitId; }
+				});
+			}
+			bench::keep(sum);
+			return iterations * lines;
+		});
+	}
+
+	void benchmarkEventLog(bench::Suite& suite)
+	{
+		NullBuffer nullBuffer;
+		std::ostream nullStream(&nullBuffer);
+
+		suite.run("EventLog::log/text", {}, [&](uint64_t iterations)
+		{
+			EventLog eventLog(nullStream);
+			for (uint64_t i = 0; i < iterations; ++i)
+			{
+				eventLog.log(i, io::UnitMoved{static_cast<uint32_t>(i), static_cast<uint32_t>(i % 1024), static_cast<uint32_t>(i / 1024)});
+			}
+			return iterations;
+		});
+
+		suite.run("EventLog::log/text-buffered", {}, [&](uint64_t iterations)
+		{
+			TextEventLog textLog(nullStream);
+			EventLog eventLog(textLog);
+			for (uint64_t i = 0; i < iterations; ++i)
+			{
+				eventLog.log(i, io::UnitMoved{static_cast<uint32_t>(i), static_cast<uint32_t>(i % 1024), static_cast<uint32_t>(i / 1024)});
+			}
+			return iterations;
+		});
+
+		suite.run("EventLog::log/binary", {}, [&](uint64_t iterations)
+		{
+			BinaryEventLog binaryLog(nullStream);
+			EventLog eventLog(binaryLog);
+			for (uint64_t i = 0; i < iterations; ++i)
+			{
+				eventLog.log(i, io::UnitMoved{static_cast<uint32_t>(i), static_cast<uint32_t>(i % 1024), static_cast<uint32_t>(i / 1024)});
+			}
+			return iterations;
+		});
+
+		suite.run("EventLog::log/callback", {}, [&](uint64_t iterations)
+		{
+			uint64_t distance = 0;
+			EventLog eventLog;
+			eventLog.onEvent<io::UnitMoved>([&distance](uint64_t, const io::UnitMoved& event) { distance += event.x + event.y; });
+			for (uint64_t i = 0; i < iterations; ++i)
+			{
+				eventLog.log(i, io::UnitMoved{static_cast<uint32_t>(i), static_cast<uint32_t>(i % 1024), static_cast<uint32_t>(i / 1024)});
+			}
+			bench::keep(distance);
+			return iterations;
+		});
+
+		// Only deaths are subscribed, so every move is dropped before it reaches a sink.
+		// keep() makes each iteration test the subscriptions again instead of hoisting the test out.
+		suite.run("EventLog::log/unsubscribed", {}, [&](uint64_t iterations)
+		{
+			uint64_t deaths = 0;
+			EventLog eventLog;
+			eventLog.onEvent<io::UnitDied>([&deaths](uint64_t, const io::UnitDied&) { ++deaths; });
+			for (uint64_t i = 0; i < iterations; ++i)
+			{
+				eventLog.log(i, io::UnitMoved{static_cast<uint32_t>(i), static_cast<uint32_t>(i % 1024), static_cast<uint32_t>(i / 1024)});
+				bench::keep(eventLog);
+			}
+			bench::keep(deaths);
+			return iterations;
+		});
+	}
+
+	void benchmarkBattle(bench::Suite& suite, ThreadPool* threadPool, const BattleParams& params)
+	{
+		EventLog eventLog = EventLog::discard();
+		GameState initialState(params.size, params.size, SimulationOptions{SEED}, eventLog);
+		populate(initialState, params);
+
+		SimulationOptions options{SEED, threadPool};
+		const int64_t threads = threadPool ? static_cast<int64_t>(threadPool->getThreadCount()) : 1;
+		suite.run("battle", {{"width", params.size}, {"height", params.size}, {"units", params.units}, {"hunter_percent", params.hunterPercent},
+			{"density_permille", int64_t{params.units} * 1000 / (int64_t{params.size} * params.size)}, {"random_targets", params.randomTargets},
+			{"threads", threads}},
+			[&](uint64_t iterations)
+			{
+				uint64_t ticks = 0;
+				for (uint64_t i = 0; i < iterations; ++i)
+				{
+					GameState state(initialState, options, eventLog);
+					state.runSimulation();
+					ticks += state.getCurrentTick();
+				}
+				bench::keep(ticks);
+				return iterations;
+			});
+	}
+
+	void benchmarkBattles(bench::Suite& suite, ThreadPool* threadPool)
+	{
+		for (int32_t size : {64, 256, 1024})
+		{
+			for (int32_t units : {256, 4096})
+			{
+				if (int64_t{units} * 4 > int64_t{size} * size)
+				{
+					continue; // Too dense to place
+				}
+
+				for (int32_t hunterPercent : {0, 50, 100})
+				{
+					benchmarkBattle(suite, threadPool, {size, units, hunterPercent});
+				}
+			}
+		}
+
+		// Every unit marching to a cell of its own, so hardly any two share a route
+		benchmarkBattle(suite, threadPool, {300, 20000, 40, 100, true});
+	}
+
+	// Ticks of a battle that has settled in: buffers have grown to their working size, so a running
+	// battle does not allocate per tick. The battle is replayed from the same point every few ticks
+	// so it cannot run out. The copy and its first tick are not counted, but copies drop the spare
+	// capacity of the routes' change lists, so the odd regrowth shows as a small allocs_per_op.
+	void benchmarkTicks(bench::Suite& suite, ThreadPool* threadPool)
+	{
+		constexpr uint64_t warmUpTicks = 20;
+		constexpr uint64_t replayTicks = 50;
+		// Mostly idle armies show what sleeping units save
+		for (auto [size, marchingPercent] : {std::pair{256, 100}, std::pair{8192, 100}, std::pair{8192, 5}})
+		{
+			constexpr int32_t units = 4096;
+			EventLog eventLog = EventLog::discard();
+			GameState settled(size, size, SimulationOptions{SEED, threadPool}, eventLog);
+			populate(settled, {size, units, 50, marchingPercent});
+			for (uint64_t tick = 0; tick < warmUpTicks; ++tick)
+			{
+				settled.runTick();
+				settled.nextTick();
+			}
+
+			GameState state(settled);
+			for (uint64_t tick = 0; tick < replayTicks; ++tick)
+			{
+				state.runTick();
+				state.nextTick();
+			}
+
+			const int64_t threads = threadPool ? static_cast<int64_t>(threadPool->getThreadCount()) : 1;
+			suite.run("GameState::runTick", {{"width", size}, {"height", size}, {"units", units}, {"hunter_percent", 50},
+				{"marching_percent", marchingPercent}, {"sparse", state.getMap().isSparse()}, {"threads", threads}},
+				[&](uint64_t iterations)
+				{
+					uint64_t active = 0;
+					for (uint64_t i = 0; i < iterations; ++i)
+					{
+						if (i % replayTicks == 0)
+						{
+							support::UncountedAllocations setup;
+							state = settled;
+							active += state.runTick();
+						}
+						else
+						{
+							active += state.runTick();
+						}
+						state.nextTick();
+					}
+					bench::keep(active);
+					return iterations;
+				});
+		}
+	}
+}
+
+// sw_battle_bench [--filter <substring>] [--min-time <ms>] [--threads <n>] [--output <file>]
+// Runs the micro- and battle benchmarks whose names contain the filter and writes the results as JSON.
+int main(int argc, char** argv)
+{
+	std::string_view filter;
+	uint64_t minMilliseconds = 200;
+	size_t threads = 1;
+	std::string outputPath;
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string_view argument = argv[i];
+		if (i + 1 >= argc)
+		{
+			throw std::runtime_error("Usage: sw_battle_bench [--filter <substring>] [--min-time <ms>] [--threads <n>] [--output <file>]");
+		}
+		const std::string_view value = argv[++i];
+
+		if (argument == "--filter")
+		{
+			filter = value;
+		}
+		else if (argument == "--min-time")
+		{
+			minMilliseconds = parseNumber<uint64_t>(argument, value);
+		}
+		else if (argument == "--threads")
+		{
+			threads = parseNumber<size_t>(argument, value);
+		}
+		else if (argument == "--output")
+		{
+			outputPath = value;
+		}
+		else
+		{
+			throw std::runtime_error("Error: Unknown option " + std::string(argument));
+		}
+	}
+
+	std::optional<ThreadPool> threadPool;
+	if (threads != 1)
+	{
+		threadPool.emplace(threads);
+	}
+
+	bench::Suite suite(filter, static_cast<double>(minMilliseconds) / 1000.0);
+	benchmarkMap(suite);
+	benchmarkQueries(suite);
+	benchmarkParser(suite);
+	benchmarkEventLog(suite);
+	benchmarkTicks(suite, threadPool ? &*threadPool : nullptr);
+	benchmarkBattles(suite, threadPool ? &*threadPool : nullptr);
+
+	if (outputPath.empty())
+	{
+		suite.writeJson(std::cout);
+		return 0;
+	}
+
+	std::ofstream file(outputPath);
+	if (!file)
+	{
+		throw std::runtime_error("Error: Cannot open output file - " + outputPath);
+	}
+	suite.writeJson(file);
+	return 0;
+}
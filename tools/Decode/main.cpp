@@ -0,0 +1,41 @@
+#include <IO/System/BinaryEventDecoder.hpp>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+// sw_battle_decode <binary log> [output file]
+// Prints the events of a log written with sw_battle_test --binary-log in the text format.
+int main(int argc, char** argv)
+{
+	using namespace sw;
+
+	if (argc < 2 || argc > 3)
+	{
+		throw std::runtime_error("Usage: sw_battle_decode <binary log> [output file]");
+	}
+
+	std::ifstream input(argv[1], std::ios::binary);
+	if (!input)
+	{
+		throw std::runtime_error("Error: File not found - " + std::string(argv[1]));
+	}
+	const std::string data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+	std::ofstream file;
+	if (argc == 3)
+	{
+		file.open(argv[2], std::ios::binary);
+		if (!file)
+		{
+			throw std::runtime_error("Error: Cannot open output file - " + std::string(argv[2]));
+		}
+	}
+	std::ostream& output = file.is_open() ? static_cast<std::ostream&>(file) : std::cout;
+
+	decodeBinaryEventLog(data, output);
+	output.flush();
+
+	return 0;
+}
@@ -0,0 +1,472 @@
+#include <IO/Commands/CreateMap.hpp>
+#include <IO/Commands/March.hpp>
+#include <IO/Commands/SpawnHunter.hpp>
+#include <IO/Commands/SpawnSwordsman.hpp>
+#include <IO/System/OptionParsing.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	using sw::parseNumber;
+
+	constexpr const char* USAGE =
+		"Usage: sw_battle_gen [--width <n>] [--height <n>] [--swordsmen <n>] [--hunters <n>]\n"
+		"                     [--layout uniform|clustered|fronts] [--clusters <n>]\n"
+		"                     [--march none|centre|across|random] [--seed <n>] [--output <file>]\n"
+		"                     [--hp <min[:max]>] [--strength <min[:max]>] [--agility <min[:max]>] [--range <min[:max]>]";
+
+	enum class Layout
+	{
+		Uniform,   // Anywhere on the map
+		Clustered, // Around a few random centres
+		Fronts     // Two bands at the left and right edges
+	};
+
+	enum class MarchPattern
+	{
+		None,
+		Centre, // Everyone to the map centre
+		Across, // To the mirrored cell on the other side of the map
+		Random  // To a random cell
+	};
+
+	struct StatRange
+	{
+		uint32_t min = 0;
+		uint32_t max = 0;
+	};
+
+	struct Options
+	{
+		uint32_t width = 100;
+		uint32_t height = 100;
+		uint64_t swordsmen = 50;
+		uint64_t hunters = 50;
+		Layout layout = Layout::Uniform;
+		uint32_t clusters = 8;
+		MarchPattern march = MarchPattern::None;
+		uint64_t seed = 1;
+		std::string outputPath;
+		StatRange hp{10, 20};
+		StatRange strength{1, 5};
+		StatRange agility{1, 5};
+		StatRange range{2, 6};
+	};
+
+	StatRange parseRange(std::string_view option, std::string_view text)
+	{
+		const size_t colon = text.find(':');
+		if (colon == std::string_view::npos)
+		{
+			const auto value = parseNumber<uint32_t>(option, text);
+			return {value, value};
+		}
+
+		const StatRange range{parseNumber<uint32_t>(option, text.substr(0, colon)), parseNumber<uint32_t>(option, text.substr(colon + 1))};
+		if (range.min > range.max)
+		{
+			throw std::runtime_error("Error: Invalid value for " + std::string(option) + ": " + std::string(text));
+		}
+		return range;
+	}
+
+	Options parseOptions(int argc, char** argv)
+	{
+		Options options;
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string_view argument = argv[i];
+			if (i + 1 >= argc)
+			{
+				throw std::runtime_error(USAGE);
+			}
+			const std::string_view value = argv[++i];
+
+			if (argument == "--width")
+			{
+				options.width = parseNumber<uint32_t>(argument, value);
+			}
+			else if (argument == "--height")
+			{
+				options.height = parseNumber<uint32_t>(argument, value);
+			}
+			else if (argument == "--swordsmen")
+			{
+				options.swordsmen = parseNumber<uint64_t>(argument, value);
+			}
+			else if (argument == "--hunters")
+			{
+				options.hunters = parseNumber<uint64_t>(argument, value);
+			}
+			else if (argument == "--layout")
+			{
+				if (value == "uniform")
+				{
+					options.layout = Layout::Uniform;
+				}
+				else if (value == "clustered")
+				{
+					options.layout = Layout::Clustered;
+				}
+				else if (value == "fronts")
+				{
+					options.layout = Layout::Fronts;
+				}
+				else
+				{
+					throw std::runtime_error("Error: Unknown layout " + std::string(value));
+				}
+			}
+			else if (argument == "--clusters")
+			{
+				options.clusters = std::max(1u, parseNumber<uint32_t>(argument, value));
+			}
+			else if (argument == "--march")
+			{
+				if (value == "none")
+				{
+					options.march = MarchPattern::None;
+				}
+				else if (value == "centre")
+				{
+					options.march = MarchPattern::Centre;
+				}
+				else if (value == "across")
+				{
+					options.march = MarchPattern::Across;
+				}
+				else if (value == "random")
+				{
+					options.march = MarchPattern::Random;
+				}
+				else
+				{
+					throw std::runtime_error("Error: Unknown march pattern " + std::string(value));
+				}
+			}
+			else if (argument == "--seed")
+			{
+				options.seed = parseNumber<uint64_t>(argument, value);
+			}
+			else if (argument == "--output")
+			{
+				options.outputPath = value;
+			}
+			else if (argument == "--hp")
+			{
+				options.hp = parseRange(argument, value);
+			}
+			else if (argument == "--strength")
+			{
+				options.strength = parseRange(argument, value);
+			}
+			else if (argument == "--agility")
+			{
+				options.agility = parseRange(argument, value);
+			}
+			else if (argument == "--range")
+			{
+				options.range = parseRange(argument, value);
+			}
+			else
+			{
+				throw std::runtime_error(USAGE);
+			}
+		}
+
+		if (options.width == 0 || options.height == 0)
+		{
+			throw std::runtime_error("Error: Map dimensions must be positive");
+		}
+		return options;
+	}
+
+	// Writes command lines through a large buffer, printing fields in the order of the command's visit()
+	class CommandWriter
+	{
+	private:
+		static constexpr size_t BufferSize = size_t{1} << 20;
+
+		std::FILE* _file;
+		std::vector<char> _buffer;
+		size_t _used = 0;
+
+		struct FieldWriter
+		{
+			CommandWriter& writer;
+
+			void visit(const char*, uint32_t value)
+			{
+				writer.put(' ');
+				char digits[16];
+				const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+				writer.put(std::string_view(digits, static_cast<size_t>(result.ptr - digits)));
+			}
+		};
+
+	public:
+		explicit CommandWriter(std::FILE* file) :
+				_file(file),
+				_buffer(BufferSize)
+		{}
+
+		template <typename TCommand>
+		void write(TCommand command)
+		{
+			put(TCommand::Name);
+			FieldWriter fields{*this};
+			command.visit(fields);
+			put('\n');
+		}
+
+		void flush()
+		{
+			if (_used > 0 && std::fwrite(_buffer.data(), 1, _used, _file) != _used)
+			{
+				throw std::runtime_error("Error: Cannot write output");
+			}
+			_used = 0;
+		}
+
+	private:
+		void put(char c)
+		{
+			if (_used == _buffer.size())
+			{
+				flush();
+			}
+			_buffer[_used++] = c;
+		}
+
+		void put(std::string_view text)
+		{
+			if (_buffer.size() - _used < text.size())
+			{
+				flush();
+			}
+			std::copy(text.begin(), text.end(), _buffer.data() + _used);
+			_used += text.size();
+		}
+	};
+
+	// Cells already handed out. A bitset while the map is small enough, otherwise a hash set.
+	class UsedCells
+	{
+	private:
+		static constexpr uint64_t MaxBitsetCells = uint64_t{1} << 32;
+
+		uint64_t _width;
+		std::vector<uint64_t> _bits;
+		std::unordered_set<uint64_t> _cells;
+
+	public:
+		UsedCells(uint32_t width, uint32_t height) :
+				_width(width)
+		{
+			const uint64_t area = uint64_t{width} * height;
+			if (area <= MaxBitsetCells)
+			{
+				_bits.assign((area + 63) / 64, 0);
+			}
+		}
+
+		// Whether the cell was free
+		bool insert(uint32_t x, uint32_t y)
+		{
+			const uint64_t index = y * _width + x;
+			if (_bits.empty())
+			{
+				return _cells.insert(index).second;
+			}
+
+			uint64_t& word = _bits[index / 64];
+			const uint64_t bit = uint64_t{1} << (index % 64);
+			const bool free = (word & bit) == 0;
+			word |= bit;
+			return free;
+		}
+	};
+
+	class Generator
+	{
+	private:
+		struct Cell
+		{
+			uint32_t x;
+			uint32_t y;
+		};
+
+		const Options& _options;
+		std::mt19937_64 _random;
+		UsedCells _used;
+		std::vector<Cell> _clusterCentres;
+		double _clusterSpread = 1;
+
+	public:
+		explicit Generator(const Options& options) :
+				_options(options),
+				_random(options.seed),
+				_used(options.width, options.height)
+		{
+			const uint64_t units = options.swordsmen + options.hunters;
+			if (units > uint64_t{options.width} * options.height / 2 || units > UINT32_MAX)
+			{
+				throw std::runtime_error("Error: Too many units for the map; at most half of the cells can be filled");
+			}
+
+			for (uint32_t i = 0; i < options.clusters; ++i)
+			{
+				_clusterCentres.push_back(randomCell(0, options.width - 1));
+			}
+			_clusterSpread = std::max(1.0, std::sqrt(static_cast<double>(units) / options.clusters));
+		}
+
+		void run(CommandWriter& writer)
+		{
+			writer.write(sw::io::CreateMap{_options.width, _options.height});
+
+			uint64_t swordsmenLeft = _options.swordsmen;
+			uint64_t huntersLeft = _options.hunters;
+			for (uint32_t unitId = 1; swordsmenLeft + huntersLeft > 0; ++unitId)
+			{
+				// Types are mixed at random in creation order
+				const bool isHunter = std::uniform_int_distribution<uint64_t>(1, swordsmenLeft + huntersLeft)(_random) <= huntersLeft;
+				const bool leftSide = (unitId % 2) == 1;
+				const Cell cell = placeUnit(leftSide);
+
+				if (isHunter)
+				{
+					--huntersLeft;
+					writer.write(sw::io::SpawnHunter{unitId, cell.x, cell.y, roll(_options.hp), roll(_options.agility), roll(_options.strength), roll(_options.range)});
+				}
+				else
+				{
+					--swordsmenLeft;
+					writer.write(sw::io::SpawnSwordsman{unitId, cell.x, cell.y, roll(_options.hp), roll(_options.strength)});
+				}
+
+				if (const auto target = marchTarget(cell))
+				{
+					writer.write(sw::io::March{unitId, target->x, target->y});
+				}
+			}
+		}
+
+	private:
+		uint32_t roll(const StatRange& range)
+		{
+			return std::uniform_int_distribution<uint32_t>(range.min, range.max)(_random);
+		}
+
+		Cell randomCell(uint32_t minX, uint32_t maxX)
+		{
+			return {std::uniform_int_distribution<uint32_t>(minX, maxX)(_random),
+				std::uniform_int_distribution<uint32_t>(0, _options.height - 1)(_random)};
+		}
+
+		Cell clusteredCell()
+		{
+			const Cell& centre = _clusterCentres[std::uniform_int_distribution<size_t>(0, _clusterCentres.size() - 1)(_random)];
+			std::normal_distribution<double> offset(0.0, _clusterSpread);
+			auto clamp = [](double value, uint32_t size)
+			{
+				return static_cast<uint32_t>(std::clamp(std::lround(value), 0l, static_cast<long>(size) - 1));
+			};
+			return {clamp(centre.x + offset(_random), _options.width), clamp(centre.y + offset(_random), _options.height)};
+		}
+
+		// Picks a free cell for the layout, falling back to anywhere on the map when the preferred
+		// area has filled up
+		Cell placeUnit(bool leftSide)
+		{
+			constexpr int Attempts = 64;
+			const uint32_t band = std::max(1u, _options.width / 4);
+			for (int attempt = 0; attempt < Attempts; ++attempt)
+			{
+				Cell cell{};
+				switch (_options.layout)
+				{
+					case Layout::Uniform:
+						cell = randomCell(0, _options.width - 1);
+						break;
+					case Layout::Clustered:
+						cell = clusteredCell();
+						break;
+					case Layout::Fronts:
+						cell = leftSide ? randomCell(0, band - 1) : randomCell(_options.width - band, _options.width - 1);
+						break;
+				}
+				if (_used.insert(cell.x, cell.y))
+				{
+					return cell;
+				}
+			}
+
+			while (true)
+			{
+				const Cell cell = randomCell(0, _options.width - 1);
+				if (_used.insert(cell.x, cell.y))
+				{
+					return cell;
+				}
+			}
+		}
+
+		std::optional<Cell> marchTarget(const Cell& cell)
+		{
+			switch (_options.march)
+			{
+				case MarchPattern::None:
+					return std::nullopt;
+				case MarchPattern::Centre:
+					return Cell{_options.width / 2, _options.height / 2};
+				case MarchPattern::Across:
+					return Cell{_options.width - 1 - cell.x, _options.height - 1 - cell.y};
+				case MarchPattern::Random:
+					return randomCell(0, _options.width - 1);
+			}
+			return std::nullopt;
+		}
+	};
+}
+
+// sw_battle_gen [options]
+// Writes a command file for sw_battle_test with a synthetic battle; see USAGE for the options.
+int main(int argc, char** argv)
+{
+	const Options options = parseOptions(argc, argv);
+
+	std::FILE* file = stdout;
+	if (!options.outputPath.empty())
+	{
+		file = std::fopen(options.outputPath.c_str(), "wb");
+		if (!file)
+		{
+			throw std::runtime_error("Error: Cannot open output file - " + options.outputPath);
+		}
+	}
+
+	{
+		Generator generator(options);
+		CommandWriter writer(file);
+		generator.run(writer);
+		writer.flush();
+	}
+
+	if (file != stdout && std::fclose(file) != 0)
+	{
+		throw std::runtime_error("Error: Cannot write output file - " + options.outputPath);
+	}
+	return 0;
+}